@@ -149,7 +149,7 @@ ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
     endif
 endif
 
-VALID_EEPROM_DRIVER_TYPES := vendor custom transient i2c spi
+VALID_EEPROM_DRIVER_TYPES := vendor custom transient i2c spi wear_leveling
 EEPROM_DRIVER ?= vendor
 ifeq ($(filter $(EEPROM_DRIVER),$(VALID_EEPROM_DRIVER_TYPES)),)
   $(call CATASTROPHIC_ERROR,Invalid EEPROM_DRIVER,EEPROM_DRIVER="$(EEPROM_DRIVER)" is not a valid EEPROM driver)
@@ -177,6 +177,18 @@ else
     OPT_DEFS += -DEEPROM_DRIVER -DEEPROM_TRANSIENT
     COMMON_VPATH += $(DRIVER_PATH)/eeprom
     SRC += eeprom_driver.c eeprom_transient.c
+  else ifeq ($(strip $(EEPROM_DRIVER)), wear_leveling)
+    # Wear-leveling EEPROM emulation -- full RAM image, write log and incremental compaction in internal flash
+    ifneq ($(filter STM32F3xx_% STM32F1xx_% %_STM32F072xB %_STM32F042x6 %_GD32VF103xB %_GD32VF103x8, $(MCU_SERIES)_$(MCU_LDSCRIPT)),)
+      OPT_DEFS += -DEEPROM_DRIVER -DEEPROM_WEAR_LEVELING -DWEAR_LEVELING_EMBEDDED_FLASH
+      COMMON_VPATH += $(DRIVER_PATH)/eeprom
+      COMMON_VPATH += $(QUANTUM_DIR)/wear_leveling
+      COMMON_VPATH += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/wear_leveling
+      SRC += eeprom_driver.c eeprom_wear_leveling.c wear_leveling.c wear_leveling_efl.c
+      SRC += $(PLATFORM_COMMON_DIR)/flash_stm32.c
+    else
+      $(call CATASTROPHIC_ERROR,Invalid EEPROM_DRIVER,EEPROM_DRIVER="wear_leveling" is not supported on this MCU)
+    endif
   else ifeq ($(strip $(EEPROM_DRIVER)), vendor)
     # Vendor-implemented EEPROM
     OPT_DEFS += -DEEPROM_VENDOR
@@ -495,7 +507,7 @@ ifeq ($(strip $(BACKLIGHT_ENABLE)), yes)
     endif
 endif
 
-VALID_WS2812_DRIVER_TYPES := bitbang pwm spi i2c
+VALID_WS2812_DRIVER_TYPES := bitbang pwm pwm_async spi i2c
 
 WS2812_DRIVER ?= bitbang
 ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
@@ -511,7 +523,7 @@ ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
         SRC += ws2812_$(strip $(WS2812_DRIVER)).c
 
         ifeq ($(strip $(PLATFORM)), CHIBIOS)
-            ifeq ($(strip $(WS2812_DRIVER)), pwm)
+            ifneq ($(filter $(strip $(WS2812_DRIVER)),pwm pwm_async),)
                 OPT_DEFS += -DSTM32_DMA_REQUIRED=TRUE
             endif
         endif
@@ -551,6 +563,12 @@ ifeq ($(strip $(VIA_ENABLE)), yes)
     OPT_DEFS += -DVIA_ENABLE
 endif
 
+ifeq ($(strip $(SCAN_STATS_ENABLE)), yes)
+    RAW_ENABLE := yes
+    SRC += $(QUANTUM_DIR)/scan_stats.c
+    OPT_DEFS += -DSCAN_STATS_ENABLE
+endif
+
 VALID_MAGIC_TYPES := yes
 BOOTMAGIC_ENABLE ?= no
 ifneq ($(strip $(BOOTMAGIC_ENABLE)), no)
@@ -588,6 +606,9 @@ endif
 DEBOUNCE_TYPE ?= sym_defer_g
 ifneq ($(strip $(DEBOUNCE_TYPE)), custom)
     QUANTUM_SRC += $(QUANTUM_DIR)/debounce/$(strip $(DEBOUNCE_TYPE)).c
+    ifeq ($(strip $(DEBOUNCE_TYPE)), asym_eager_defer_ts)
+        OPT_DEFS += -DDEBOUNCE_TRACKS_EXPIRY
+    endif
 endif
 
 ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
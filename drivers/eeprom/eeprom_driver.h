@@ -20,3 +20,6 @@
 
 void eeprom_driver_init(void);
 void eeprom_driver_erase(void);
+
+// Background maintenance, only implemented by drivers that need it (EEPROM_WEAR_LEVELING)
+void eeprom_driver_task(void);
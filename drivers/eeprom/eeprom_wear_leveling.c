@@ -0,0 +1,44 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdint.h>
+#include <string.h>
+
+#include "eeprom_driver.h"
+#include "wear_leveling.h"
+
+static size_t clamp_length(intptr_t offset, size_t len) {
+    if (offset + len > WEAR_LEVELING_LOGICAL_SIZE) {
+        len = offset < WEAR_LEVELING_LOGICAL_SIZE ? WEAR_LEVELING_LOGICAL_SIZE - offset : 0;
+    }
+    return len;
+}
+
+void eeprom_driver_init(void) {
+    wear_leveling_init();
+}
+
+void eeprom_driver_erase(void) {
+    wear_leveling_erase();
+}
+
+void eeprom_driver_task(void) {
+    wear_leveling_task();
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    intptr_t offset = (intptr_t)addr;
+    memset(buf, 0x00, len);
+    len = clamp_length(offset, len);
+    if (len > 0) {
+        wear_leveling_read(offset, buf, len);
+    }
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    intptr_t offset = (intptr_t)addr;
+    len             = clamp_length(offset, len);
+    if (len > 0) {
+        wear_leveling_write(offset, buf, len);
+    }
+}
@@ -85,16 +85,35 @@ bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 // 0x0E - R17,G15,G14,G13,G12,G11,G10,G09
 // 0x10 - R16,R15,R14,R13,R12,R11,R10,R09
 
+#ifdef I2C_ASYNC_ENABLE
+// Transfers are queued and sent in the background. After a failed one the
+// state of the driver is unknown, so the next update sends everything again.
+static void IS31FL3731_transfer_done(i2c_status_t status) {
+    if (status != I2C_STATUS_SUCCESS) {
+        for (uint8_t i = 0; i < DRIVER_COUNT; i++) {
+            g_pwm_buffer_update_required[i]            = true;
+            g_led_control_registers_update_required[i] = true;
+        }
+    }
+}
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit_async((addr) << 1, data, length, ISSI_TIMEOUT, IS31FL3731_transfer_done)
+#    if ISSI_PERSISTENCE > 0
+#        error "ISSI_PERSISTENCE cannot be used with I2C_ASYNC_ENABLE, failed transfers are resent by the next update instead"
+#    endif
+#else
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit((addr) << 1, data, length, ISSI_TIMEOUT)
+#endif
+
 void IS31FL3731_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     g_twi_transfer_buffer[0] = reg;
     g_twi_transfer_buffer[1] = data;
 
 #if ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) == 0) break;
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2) == 0) break;
     }
 #else
-    i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT);
+    ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2);
 #endif
 }
 
@@ -117,10 +136,10 @@ void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
 
 #if ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
+            if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 17) == 0) break;
         }
 #else
-        i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
+        ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 17);
 #endif
     }
 }
@@ -140,6 +159,9 @@ void IS31FL3731_init(uint8_t addr) {
     IS31FL3731_write_register(addr, ISSI_REG_GHOST_IMAGE_PREVENTION, 0x10);
 #endif
 
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_wait();
+#endif
     // this delay was copied from other drivers, might not be needed
     wait_ms(10);
 
@@ -94,6 +94,25 @@ uint8_t g_led_control_registers[LED_DRIVER_COUNT][24] = {{0}, {0}, {0}, {0}};
 #endif
 bool g_led_control_registers_update_required[LED_DRIVER_COUNT] = {false};
 
+#ifdef I2C_ASYNC_ENABLE
+// Transfers are queued and sent in the background. After a failed one the
+// state of the driver is unknown, so the next update sends everything again.
+static void IS31FL3733_transfer_done(i2c_status_t status) {
+    if (status != I2C_STATUS_SUCCESS) {
+        for (uint8_t i = 0; i < LED_DRIVER_COUNT; i++) {
+            g_pwm_buffer_update_required[i]            = true;
+            g_led_control_registers_update_required[i] = true;
+        }
+    }
+}
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit_async((addr) << 1, data, length, ISSI_TIMEOUT, IS31FL3733_transfer_done)
+#    if ISSI_PERSISTENCE > 0
+#        error "ISSI_PERSISTENCE cannot be used with I2C_ASYNC_ENABLE, failed transfers are resent by the next update instead"
+#    endif
+#else
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit((addr) << 1, data, length, ISSI_TIMEOUT)
+#endif
+
 bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     // If the transaction fails function returns false.
     g_twi_transfer_buffer[0] = reg;
@@ -101,12 +120,12 @@ bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 
 #if ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) != 0) {
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2) != 0) {
             return false;
         }
     }
 #else
-    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) != 0) {
+    if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2) != 0) {
         return false;
     }
 #endif
@@ -131,12 +150,12 @@ bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
 
 #if ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
+            if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 17) != 0) {
                 return false;
             }
         }
 #else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 17) != 0) {
             return false;
         }
 #endif
@@ -186,6 +205,9 @@ void IS31FL3733_init(uint8_t addr, uint8_t sync) {
     // Disable software shutdown.
     IS31FL3733_write_register(addr, ISSI_REG_CONFIGURATION, ((sync & 0b11) << 6) | ((ISSI_PWM_FREQUENCY & 0b111) << 3) | 0x01);
 
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_wait();
+#endif
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
 }
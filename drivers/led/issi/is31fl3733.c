@@ -78,12 +78,36 @@ uint8_t g_twi_transfer_buffer[20];
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in IS31FL3733_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[DRIVER_COUNT][192];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+// The whole PWM buffer is sent on the first update, after that only the
+// 16 byte transfers holding changed values are sent. Setting
+// g_pwm_buffer_update_required without marking any transfer sends all of them.
+uint8_t  g_pwm_buffer[DRIVER_COUNT][192];
+bool     g_pwm_buffer_update_required[DRIVER_COUNT] = {[0 ... DRIVER_COUNT - 1] = true};
+uint16_t g_pwm_buffer_dirty_transfers[DRIVER_COUNT] = {[0 ... DRIVER_COUNT - 1] = 0x0FFF};
 
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
+#ifdef I2C_ASYNC_ENABLE
+// Transfers are queued and sent in the background. After a failed one the
+// state of the driver is unknown, so the next update sends everything again.
+static void IS31FL3733_transfer_done(i2c_status_t status) {
+    if (status != I2C_STATUS_SUCCESS) {
+        for (uint8_t i = 0; i < DRIVER_COUNT; i++) {
+            g_pwm_buffer_update_required[i]            = true;
+            g_led_control_registers_update_required[i] = true;
+            g_pwm_buffer_dirty_transfers[i]            = 0x0FFF;
+        }
+    }
+}
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit_async((addr) << 1, data, length, ISSI_TIMEOUT, IS31FL3733_transfer_done)
+#    if ISSI_PERSISTENCE > 0
+#        error "ISSI_PERSISTENCE cannot be used with I2C_ASYNC_ENABLE, failed transfers are resent by the next update instead"
+#    endif
+#else
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit((addr) << 1, data, length, ISSI_TIMEOUT)
+#endif
+
 bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     // If the transaction fails function returns false.
     g_twi_transfer_buffer[0] = reg;
@@ -91,12 +115,12 @@ bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 
 #if ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) != 0) {
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2) != 0) {
             return false;
         }
     }
 #else
-    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) != 0) {
+    if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2) != 0) {
         return false;
     }
 #endif
@@ -104,13 +128,24 @@ bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 }
 
 bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    uint16_t all_transfers = 0x0FFF;
+    return IS31FL3733_write_pwm_buffer_transfers(addr, pwm_buffer, &all_transfers);
+}
+
+bool IS31FL3733_write_pwm_buffer_transfers(uint8_t addr, uint8_t *pwm_buffer, uint16_t *transfers) {
     // Assumes PG1 is already selected.
     // If any of the transactions fails function returns false.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
+    // Transmit PWM registers in up to 12 transfers of 16 bytes,
+    // skipping the transfers whose bit is not set in *transfers.
+    // Bits of the transfers that were sent are cleared.
     // g_twi_transfer_buffer[] is 20 bytes
 
     // Iterate over the pwm_buffer contents at 16 byte intervals.
     for (int i = 0; i < 192; i += 16) {
+        if (!(*transfers & (1 << (i / 16)))) {
+            continue;
+        }
+
         g_twi_transfer_buffer[0] = i;
         // Copy the data from i to i+15.
         // Device will auto-increment register for data after the first byte
@@ -121,15 +156,16 @@ bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
 
 #if ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
+            if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 17) != 0) {
                 return false;
             }
         }
 #else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 17) != 0) {
             return false;
         }
 #endif
+        *transfers &= ~(1 << (i / 16));
     }
     return true;
 }
@@ -176,19 +212,29 @@ void IS31FL3733_init(uint8_t addr, uint8_t sync) {
     // Disable software shutdown.
     IS31FL3733_write_register(addr, ISSI_REG_CONFIGURATION, ((sync & 0b11) << 6) | ((ISSI_PWM_FREQUENCY & 0b111) << 3) | 0x01);
 
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_wait();
+#endif
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
 }
 
+static inline void IS31FL3733_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty_transfers[driver] |= 1 << (reg / 16);
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     is31_led led;
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3733_set_pwm_register(led.driver, led.r, red);
+        IS31FL3733_set_pwm_register(led.driver, led.g, green);
+        IS31FL3733_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -234,13 +280,17 @@ void IS31FL3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
+        if (g_pwm_buffer_dirty_transfers[index] == 0) {
+            g_pwm_buffer_dirty_transfers[index] = 0x0FFF;
+        }
+
         // If any of the transactions fail we risk writing dirty PG0,
         // refresh page 0 just in case.
-        if (!IS31FL3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        if (!IS31FL3733_write_pwm_buffer_transfers(addr, g_pwm_buffer[index], &g_pwm_buffer_dirty_transfers[index])) {
             g_led_control_registers_update_required[index] = true;
         }
     }
-    g_pwm_buffer_update_required[index] = false;
+    g_pwm_buffer_update_required[index] = g_pwm_buffer_dirty_transfers[index] != 0;
 }
 
 void IS31FL3733_update_led_control_registers(uint8_t addr, uint8_t index) {
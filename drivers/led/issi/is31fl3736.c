@@ -78,16 +78,33 @@ bool    g_pwm_buffer_update_required = false;
 uint8_t g_led_control_registers[DRIVER_COUNT][24] = {{0}, {0}};
 bool    g_led_control_registers_update_required   = false;
 
+#ifdef I2C_ASYNC_ENABLE
+// Transfers are queued and sent in the background. After a failed one the
+// state of the driver is unknown, so the next update sends everything again.
+static void IS31FL3736_transfer_done(i2c_status_t status) {
+    if (status != I2C_STATUS_SUCCESS) {
+        g_pwm_buffer_update_required            = true;
+        g_led_control_registers_update_required = true;
+    }
+}
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit_async((addr) << 1, data, length, ISSI_TIMEOUT, IS31FL3736_transfer_done)
+#    if ISSI_PERSISTENCE > 0
+#        error "ISSI_PERSISTENCE cannot be used with I2C_ASYNC_ENABLE, failed transfers are resent by the next update instead"
+#    endif
+#else
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit((addr) << 1, data, length, ISSI_TIMEOUT)
+#endif
+
 void IS31FL3736_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     g_twi_transfer_buffer[0] = reg;
     g_twi_transfer_buffer[1] = data;
 
 #if ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) == 0) break;
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2) == 0) break;
     }
 #else
-    i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT);
+    ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2);
 #endif
 }
 
@@ -109,10 +126,10 @@ void IS31FL3736_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
 
 #if ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
+            if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 17) == 0) break;
         }
 #else
-        i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
+        ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 17);
 #endif
     }
 }
@@ -158,6 +175,9 @@ void IS31FL3736_init(uint8_t addr) {
     // Disable software shutdown.
     IS31FL3736_write_register(addr, ISSI_REG_CONFIGURATION, 0x01);
 
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_wait();
+#endif
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
 }
@@ -80,69 +80,94 @@ uint8_t g_twi_transfer_buffer[20] = {0xFF};
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in IS31FL3741_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT]        = {false};
-bool    g_scaling_registers_update_required[DRIVER_COUNT] = {false};
+// The whole PWM buffer is sent on the first update, after that only the
+// 18 byte transfers holding changed values are sent. Setting
+// g_pwm_buffer_update_required without marking any transfer sends all of them.
+#define ISSI_PWM_TRANSFERS_ALL 0xFFFFFUL
+
+uint8_t  g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
+bool     g_pwm_buffer_update_required[DRIVER_COUNT]        = {[0 ... DRIVER_COUNT - 1] = true};
+uint32_t g_pwm_buffer_dirty_transfers[DRIVER_COUNT]        = {[0 ... DRIVER_COUNT - 1] = ISSI_PWM_TRANSFERS_ALL};
+bool     g_scaling_registers_update_required[DRIVER_COUNT] = {false};
 
 uint8_t g_scaling_registers[DRIVER_COUNT][ISSI_MAX_LEDS];
 
+#ifdef I2C_ASYNC_ENABLE
+// Transfers are queued and sent in the background. After a failed one the
+// state of the driver is unknown, so the next update sends everything again.
+static void IS31FL3741_transfer_done(i2c_status_t status) {
+    if (status != I2C_STATUS_SUCCESS) {
+        for (uint8_t i = 0; i < DRIVER_COUNT; i++) {
+            g_pwm_buffer_update_required[i]        = true;
+            g_scaling_registers_update_required[i] = true;
+            g_pwm_buffer_dirty_transfers[i]        = ISSI_PWM_TRANSFERS_ALL;
+        }
+    }
+}
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit_async((addr) << 1, data, length, ISSI_TIMEOUT, IS31FL3741_transfer_done)
+#    if ISSI_PERSISTENCE > 0
+#        error "ISSI_PERSISTENCE cannot be used with I2C_ASYNC_ENABLE, failed transfers are resent by the next update instead"
+#    endif
+#else
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit((addr) << 1, data, length, ISSI_TIMEOUT)
+#endif
+
 void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     g_twi_transfer_buffer[0] = reg;
     g_twi_transfer_buffer[1] = data;
 
 #if ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) == 0) break;
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2) == 0) break;
     }
 #else
-    i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT);
+    ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2);
 #endif
 }
 
 bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
-    // unlock the command register and select PG2
-    IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-    IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM0);
+    uint32_t all_transfers = ISSI_PWM_TRANSFERS_ALL;
+    return IS31FL3741_write_pwm_buffer_transfers(addr, pwm_buffer, &all_transfers);
+}
+
+bool IS31FL3741_write_pwm_buffer_transfers(uint8_t addr, uint8_t *pwm_buffer, uint32_t *transfers) {
+    // Transmit PWM registers in up to 20 transfers of 18 bytes (the last one
+    // holds the remaining 9), skipping the transfers whose bit is not set in
+    // *transfers. Bits of the transfers that were sent are cleared.
+    uint8_t page = 0xFF;
+
+    for (int i = 0; i < ISSI_MAX_LEDS; i += 18) {
+        if (!(*transfers & (1UL << (i / 18)))) {
+            continue;
+        }
 
-    for (int i = 0; i < 342; i += 18) {
-        if (i == 180) {
-            // unlock the command register and select PG2
+        if (page != (i < 180 ? ISSI_PAGE_PWM0 : ISSI_PAGE_PWM1)) {
+            page = i < 180 ? ISSI_PAGE_PWM0 : ISSI_PAGE_PWM1;
+            // unlock the command register and select the PWM page
             IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM1);
+            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, page);
         }
 
+        // the last transfer only holds the remaining 9 registers, the total number is 351
+        uint8_t size = i + 18 > ISSI_MAX_LEDS ? ISSI_MAX_LEDS - i : 18;
+
         g_twi_transfer_buffer[0] = i % 180;
-        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, 18);
+        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, size);
 
 #if ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
+            if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, size + 1) != 0) {
                 return false;
             }
         }
 #else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, size + 1) != 0) {
             return false;
         }
 #endif
+        *transfers &= ~(1UL << (i / 18));
     }
 
-    // transfer the left cause the total number is 351
-    g_twi_transfer_buffer[0] = 162;
-    memcpy(g_twi_transfer_buffer + 1, pwm_buffer + 342, 9);
-
-#if ISSI_PERSISTENCE > 0
-    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
-            return false;
-        }
-    }
-#else
-    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
-        return false;
-    }
-#endif
-
     return true;
 }
 
@@ -169,19 +194,29 @@ void IS31FL3741_init(uint8_t addr) {
 
     // IS31FL3741_update_led_scaling_registers(addr, 0xFF, 0xFF, 0xFF);
 
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_wait();
+#endif
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
 }
 
+static inline void IS31FL3741_set_pwm_register(uint8_t driver, uint16_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty_transfers[driver] |= 1UL << (reg / 18);
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     is31_led led;
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3741_set_pwm_register(led.driver, led.r, red);
+        IS31FL3741_set_pwm_register(led.driver, led.g, green);
+        IS31FL3741_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -218,18 +253,20 @@ void IS31FL3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void IS31FL3741_update_pwm_buffers(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
-        IS31FL3741_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        if (g_pwm_buffer_dirty_transfers[index] == 0) {
+            g_pwm_buffer_dirty_transfers[index] = ISSI_PWM_TRANSFERS_ALL;
+        }
+
+        IS31FL3741_write_pwm_buffer_transfers(addr, g_pwm_buffer[index], &g_pwm_buffer_dirty_transfers[index]);
     }
 
-    g_pwm_buffer_update_required[index] = false;
+    g_pwm_buffer_update_required[index] = g_pwm_buffer_dirty_transfers[index] != 0;
 }
 
 void IS31FL3741_set_pwm_buffer(const is31_led *pled, uint8_t red, uint8_t green, uint8_t blue) {
-    g_pwm_buffer[pled->driver][pled->r] = red;
-    g_pwm_buffer[pled->driver][pled->g] = green;
-    g_pwm_buffer[pled->driver][pled->b] = blue;
-
-    g_pwm_buffer_update_required[pled->driver] = true;
+    IS31FL3741_set_pwm_register(pled->driver, pled->r, red);
+    IS31FL3741_set_pwm_register(pled->driver, pled->g, green);
+    IS31FL3741_set_pwm_register(pled->driver, pled->b, blue);
 }
 
 void IS31FL3741_update_led_control_registers(uint8_t addr, uint8_t index) {
@@ -36,12 +36,38 @@ uint8_t g_twi_transfer_buffer[20];
 
 // These buffers match the PWM & scaling registers.
 // Storing them like this is optimal for I2C transfers to the registers.
-uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+// The whole PWM buffer is sent on the first update, after that only the
+// transfers holding changed values are sent. Setting
+// g_pwm_buffer_update_required without marking any transfer sends all of them.
+#define ISSI_PWM_TRANSFERS_ALL ((1UL << ((ISSI_MAX_LEDS + ISSI_PWM_TRF_SIZE - 1) / ISSI_PWM_TRF_SIZE)) - 1)
+
+uint8_t  g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
+bool     g_pwm_buffer_update_required[DRIVER_COUNT] = {[0 ... DRIVER_COUNT - 1] = true};
+uint32_t g_pwm_buffer_dirty_transfers[DRIVER_COUNT] = {[0 ... DRIVER_COUNT - 1] = ISSI_PWM_TRANSFERS_ALL};
 
 uint8_t g_scaling_buffer[DRIVER_COUNT][ISSI_SCALING_SIZE];
 bool    g_scaling_buffer_update_required[DRIVER_COUNT] = {false};
 
+#ifdef I2C_ASYNC_ENABLE
+// Transfers are queued and sent in the background. After a failed one the
+// state of the driver is unknown, so the next update sends everything again.
+static void IS31FL_transfer_done(i2c_status_t status) {
+    if (status != I2C_STATUS_SUCCESS) {
+        for (uint8_t i = 0; i < DRIVER_COUNT; i++) {
+            g_pwm_buffer_update_required[i]     = true;
+            g_scaling_buffer_update_required[i] = true;
+            g_pwm_buffer_dirty_transfers[i]     = ISSI_PWM_TRANSFERS_ALL;
+        }
+    }
+}
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit_async((addr) << 1, data, length, ISSI_TIMEOUT, IS31FL_transfer_done)
+#    if ISSI_PERSISTENCE > 0
+#        error "ISSI_PERSISTENCE cannot be used with I2C_ASYNC_ENABLE, failed transfers are resent by the next update instead"
+#    endif
+#else
+#    define ISSI_TRANSMIT(addr, data, length) i2c_transmit((addr) << 1, data, length, ISSI_TIMEOUT)
+#endif
+
 // For writing of single register entry
 void IS31FL_write_single_register(uint8_t addr, uint8_t reg, uint8_t data) {
     // Set register address and register data ready to write
@@ -50,10 +76,10 @@ void IS31FL_write_single_register(uint8_t addr, uint8_t reg, uint8_t data) {
 
 #if ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) == 0) break;
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2) == 0) break;
     }
 #else
-    i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT);
+    ISSI_TRANSMIT(addr, g_twi_transfer_buffer, 2);
 #endif
 }
 
@@ -70,12 +96,12 @@ bool IS31FL_write_multi_registers(uint8_t addr, uint8_t *source_buffer, uint8_t
 
 #if ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, transfer_size + 1, ISSI_TIMEOUT) != 0) {
+            if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, transfer_size + 1) != 0) {
                 return false;
             }
         }
 #else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, transfer_size + 1, ISSI_TIMEOUT) != 0) {
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, transfer_size + 1) != 0) {
             return false;
         }
 #endif
@@ -83,6 +109,33 @@ bool IS31FL_write_multi_registers(uint8_t addr, uint8_t *source_buffer, uint8_t
     return true;
 }
 
+// As IS31FL_write_multi_registers, but only the transfers whose bit is set in
+// *transfers are sent. Bits of the transfers that were sent are cleared.
+bool IS31FL_write_dirty_registers(uint8_t addr, uint8_t *source_buffer, uint8_t buffer_size, uint8_t transfer_size, uint8_t start_reg_addr, uint32_t *transfers) {
+    for (int i = 0; i < buffer_size; i += transfer_size) {
+        if (!(*transfers & (1UL << (i / transfer_size)))) {
+            continue;
+        }
+
+        g_twi_transfer_buffer[0] = i + start_reg_addr;
+        memcpy(g_twi_transfer_buffer + 1, source_buffer + i, transfer_size);
+
+#if ISSI_PERSISTENCE > 0
+        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+            if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, transfer_size + 1) != 0) {
+                return false;
+            }
+        }
+#else
+        if (ISSI_TRANSMIT(addr, g_twi_transfer_buffer, transfer_size + 1) != 0) {
+            return false;
+        }
+#endif
+        *transfers &= ~(1UL << (i / transfer_size));
+    }
+    return true;
+}
+
 void IS31FL_unlock_register(uint8_t addr, uint8_t page) {
     // unlock the command register and select Page to write
     IS31FL_write_single_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, ISSI_REGISTER_UNLOCK);
@@ -116,18 +169,33 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
     IS31FL_write_single_register(addr, ISSI_REG_PWM_SET, ISSI_PWM_SET);
 #endif
 
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_wait();
+#endif
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
 }
 
 void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
+        // Send everything if the buffer was marked without tracking the changes
+        if (g_pwm_buffer_dirty_transfers[index] == 0) {
+            g_pwm_buffer_dirty_transfers[index] = ISSI_PWM_TRANSFERS_ALL;
+        }
         // Queue up the correct page
         IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
-        // Update flags that pwm_buffer has been updated
-        g_pwm_buffer_update_required[index] = false;
+        // Hand off the update to IS31FL_write_dirty_registers, which only sends the changed transfers
+        IS31FL_write_dirty_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST, &g_pwm_buffer_dirty_transfers[index]);
+        // Update flags that pwm_buffer has been updated, failed transfers are retried on the next update
+        g_pwm_buffer_update_required[index] = g_pwm_buffer_dirty_transfers[index] != 0;
+    }
+}
+
+static inline void IS31FL_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty_transfers[driver] |= 1UL << (reg / ISSI_PWM_TRF_SIZE);
+        g_pwm_buffer_update_required[driver] = true;
     }
 }
 
@@ -168,10 +236,9 @@ void IS31FL_RGB_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm_register(led.driver, led.r, red);
+        IS31FL_set_pwm_register(led.driver, led.g, green);
+        IS31FL_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -217,8 +284,7 @@ void IS31FL_simple_set_scaling_buffer(uint8_t index, bool value) {
 void IS31FL_simple_set_brightness(int index, uint8_t value) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
-        g_pwm_buffer[led.driver][led.v] = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm_register(led.driver, led.v, value);
     }
 }
 
@@ -59,6 +59,7 @@ extern const is31_led __flash g_is31_leds[DRIVER_LED_TOTAL];
 
 void IS31FL_write_single_register(uint8_t addr, uint8_t reg, uint8_t data);
 bool IS31FL_write_multi_registers(uint8_t addr, uint8_t *source_buffer, uint8_t buffer_size, uint8_t transfer_size, uint8_t start_reg_addr);
+bool IS31FL_write_dirty_registers(uint8_t addr, uint8_t *source_buffer, uint8_t buffer_size, uint8_t transfer_size, uint8_t start_reg_addr, uint32_t *transfers);
 void IS31FL_unlock_register(uint8_t addr, uint8_t page);
 void IS31FL_common_init(uint8_t addr, uint8_t ssr);
 
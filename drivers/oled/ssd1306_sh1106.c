@@ -91,6 +91,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 
 #define OLED_ALL_BLOCKS_MASK (((((OLED_BLOCK_TYPE)1 << (OLED_BLOCK_COUNT - 1)) - 1) << 1) | 1)
+#define OLED_BLOCK_BIT(block) ((OLED_BLOCK_TYPE)1 << (block))
+
+// Render budget
+#ifndef OLED_RENDER_BUDGET_US
+#    define OLED_RENDER_BUDGET_US 2000
+#endif
+#ifndef OLED_I2C_BYTE_US
+#    if defined(F_SCL)
+#        define OLED_I2C_BYTE_US ((9000000UL + F_SCL - 1) / F_SCL)
+#    else
+#        define OLED_I2C_BYTE_US 23 // 9 clocks at 400kHz
+#    endif
+#endif
+#define OLED_RENDER_BUDGET_BYTES (OLED_RENDER_BUDGET_US / OLED_I2C_BYTE_US)
+// Address and control bytes of a position command and its data transfer
+#define OLED_TRANSFER_OVERHEAD 10
 
 // i2c defines
 #define I2C_CMD 0x00
@@ -102,6 +118,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif // defined(__AVR__)
 #define I2C_TRANSMIT(data) i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT)
 #define I2C_WRITE_REG(mode, data, size) i2c_writeReg((OLED_DISPLAY_ADDRESS << 1), mode, data, size, OLED_I2C_TIMEOUT)
+#ifdef I2C_ASYNC_ENABLE
+// Rendering only queues its transfers, they are sent while the keyboard carries on
+static void oled_render_done(i2c_status_t status);
+#    define I2C_RENDER_TRANSMIT(data) i2c_transmit_async((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT, oled_render_done)
+#    define I2C_RENDER_WRITE_REG(mode, data, size) i2c_writeReg_async((OLED_DISPLAY_ADDRESS << 1), mode, data, size, OLED_I2C_TIMEOUT, oled_render_done)
+// Merged ranges are queued as one packet, after the register byte
+#    define OLED_RENDER_RANGE_MAX_BYTES (I2C_ASYNC_BUFFER_SIZE - 1)
+#else
+#    define I2C_RENDER_TRANSMIT(data) I2C_TRANSMIT(data)
+#    define I2C_RENDER_WRITE_REG(mode, data, size) I2C_WRITE_REG(mode, data, size)
+#    define OLED_RENDER_RANGE_MAX_BYTES OLED_MATRIX_SIZE
+#endif
 
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 
@@ -122,6 +150,11 @@ uint8_t         oled_rotation_width = 0;
 uint8_t         oled_scroll_speed   = 0; // this holds the speed after being remapped to ssd1306 internal values
 uint8_t         oled_scroll_start   = 0;
 uint8_t         oled_scroll_end     = 7;
+#ifdef OLED_RENDER_SHADOW
+// What the display currently shows, unknown for the blocks in oled_shadow_stale
+static uint8_t         oled_shadow[OLED_MATRIX_SIZE];
+static OLED_BLOCK_TYPE oled_shadow_stale = OLED_ALL_BLOCKS_MASK;
+#endif
 #if OLED_TIMEOUT > 0
 uint32_t oled_timeout;
 #endif
@@ -226,6 +259,10 @@ bool oled_init(oled_rotation_t rotation) {
 #endif
 
     oled_clear();
+#ifdef OLED_RENDER_SHADOW
+    // Display RAM is undefined after power up
+    oled_shadow_stale = OLED_ALL_BLOCKS_MASK;
+#endif
     oled_initialized = true;
     oled_active      = true;
     oled_scrolling   = false;
@@ -245,10 +282,10 @@ void oled_clear(void) {
     oled_dirty  = OLED_ALL_BLOCKS_MASK;
 }
 
-static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
+static void calc_bounds(uint16_t start, uint16_t end, uint8_t *cmd_array) {
     // Calculate commands to set memory addressing bounds.
-    uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
-    uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
+    uint8_t start_page   = start / OLED_DISPLAY_WIDTH;
+    uint8_t start_column = start % OLED_DISPLAY_WIDTH;
 #if (OLED_IC == OLED_IC_SH1106)
     // Commands for Page Addressing Mode. Sets starting page and column; has no end bound.
     // Column value must be split into high and low nybble and sent as two commands.
@@ -258,12 +295,14 @@ static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
     cmd_array[3] = NOP;
     cmd_array[4] = NOP;
     cmd_array[5] = NOP;
+    (void)end;
 #else
     // Commands for use in Horizontal Addressing mode.
+    // Ranges spanning pages cover them completely, so the window is either one page or full width.
     cmd_array[1] = start_column;
+    cmd_array[2] = (end - 1) % OLED_DISPLAY_WIDTH;
     cmd_array[4] = start_page;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1;
+    cmd_array[5] = (end - 1) / OLED_DISPLAY_WIDTH;
 #endif
 }
 
@@ -290,66 +329,191 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
-void oled_render(void) {
-    if (!oled_initialized) {
-        return;
+#ifdef OLED_RENDER_SHADOW
+static inline bool oled_shadow_matches(uint16_t index) {
+    return !(oled_shadow_stale & OLED_BLOCK_BIT(index / OLED_BLOCK_SIZE)) && oled_buffer[index] == oled_shadow[index];
+}
+#endif
+
+static bool oled_send_range(uint16_t start, uint16_t end) {
+    // Set column & page position
+    static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
+    calc_bounds(start, end, &display_start[1]); // Offset from I2C_CMD byte at the start
+
+    // Send column & page position
+    if (I2C_RENDER_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
+        print("oled_render offset command failed\n");
+        return false;
     }
 
-    // Do we have work to do?
-    oled_dirty &= OLED_ALL_BLOCKS_MASK;
-    if (!oled_dirty || oled_scrolling) {
-        return;
+    // Send render data chunk as is
+    if (I2C_RENDER_WRITE_REG(I2C_DATA, &oled_buffer[start], end - start) != I2C_STATUS_SUCCESS) {
+        print("oled_render data failed\n");
+        return false;
+    }
+
+#ifdef OLED_RENDER_SHADOW
+    memcpy(&oled_shadow[start], &oled_buffer[start], end - start);
+#endif
+    return true;
+}
+
+// A transfer can only span pages it covers completely
+static uint16_t oled_page_split(uint16_t start, uint16_t end) {
+    uint16_t page_end = (start / OLED_DISPLAY_WIDTH + 1) * OLED_DISPLAY_WIDTH;
+#if (OLED_IC == OLED_IC_SH1106)
+    if (end > page_end) {
+#else
+    if (end > page_end && (start % OLED_DISPLAY_WIDTH || end % OLED_DISPLAY_WIDTH)) {
+#endif
+        end = page_end;
+    }
+    return end;
+}
+
+// Number of transfers oled_render_range() needs for [start, end) when all of it changed
+static uint8_t oled_range_transfers(uint16_t start, uint16_t end) {
+    uint8_t transfers = 0;
+    while (start < end) {
+        start = oled_page_split(start, end);
+        transfers++;
+    }
+    return transfers;
+}
+
+// Sends the part of oled_buffer[start, end) that changed, as few transfers as possible
+static bool oled_render_range(uint16_t start, uint16_t end, uint16_t *sent) {
+    while (start < end) {
+        uint16_t segment_end = end;
+#ifdef OLED_RENDER_SHADOW
+        // Skip what the display already shows
+        while (start < end && oled_shadow_matches(start)) {
+            ++start;
+        }
+        if (start == end) {
+            break;
+        }
+
+        // End at the last change before an unchanged gap that costs more to send than a new transfer
+        uint16_t last_change = start;
+        for (uint16_t i = start + 1; i < end && i - last_change <= OLED_TRANSFER_OVERHEAD; ++i) {
+            if (!oled_shadow_matches(i)) {
+                last_change = i;
+            }
+        }
+        segment_end = last_change + 1;
+#endif
+
+        segment_end = oled_page_split(start, segment_end);
+        if (!oled_send_range(start, segment_end)) {
+            return false;
+        }
+        *sent += segment_end - start + OLED_TRANSFER_OVERHEAD;
+        start = segment_end;
     }
+    return true;
+}
 
-    // Find first dirty block
-    uint8_t update_start = 0;
-    while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
-        ++update_start;
+static bool oled_render_block_90(uint8_t block, uint16_t *sent) {
+#ifdef OLED_RENDER_SHADOW
+    if (!(oled_shadow_stale & OLED_BLOCK_BIT(block)) && !memcmp(&oled_buffer[OLED_BLOCK_SIZE * block], &oled_shadow[OLED_BLOCK_SIZE * block], OLED_BLOCK_SIZE)) {
+        return true;
     }
+#endif
 
     // Set column & page position
     static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
-    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-        calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-    } else {
-        calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-    }
+    calc_bounds_90(block, &display_start[1]); // Offset from I2C_CMD byte at the start
 
     // Send column & page position
-    if (I2C_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
+    if (I2C_RENDER_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
         print("oled_render offset command failed\n");
+        return false;
+    }
+
+    // Rotate the render chunks
+    const static uint8_t source_map[] = OLED_SOURCE_MAP;
+    const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+    static uint8_t temp_buffer[OLED_BLOCK_SIZE];
+    memset(temp_buffer, 0, sizeof(temp_buffer));
+    for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+        rotate_90(&oled_buffer[OLED_BLOCK_SIZE * block + source_map[i]], &temp_buffer[target_map[i]]);
+    }
+
+    // Send render data chunk after rotating
+    if (I2C_RENDER_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+        print("oled_render90 data failed\n");
+        return false;
+    }
+
+#ifdef OLED_RENDER_SHADOW
+    memcpy(&oled_shadow[OLED_BLOCK_SIZE * block], &oled_buffer[OLED_BLOCK_SIZE * block], OLED_BLOCK_SIZE);
+#endif
+    *sent += OLED_BLOCK_SIZE + OLED_TRANSFER_OVERHEAD;
+    return true;
+}
+
+#ifdef I2C_ASYNC_ENABLE
+static void oled_render_done(i2c_status_t status) {
+    if (status != I2C_STATUS_SUCCESS) {
+        print("oled_render transfer failed\n");
+        // Which part of the display it was is not known, redraw all of it
+        oled_dirty = OLED_ALL_BLOCKS_MASK;
+#    ifdef OLED_RENDER_SHADOW
+        oled_shadow_stale = OLED_ALL_BLOCKS_MASK;
+#    endif
+    }
+}
+#endif
+
+void oled_render(void) {
+    _Static_assert(OLED_BLOCK_SIZE <= OLED_RENDER_RANGE_MAX_BYTES, "I2C_ASYNC_BUFFER_SIZE cannot hold a block of the display");
+
+    if (!oled_initialized) {
         return;
     }
 
-    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-        // Send render data chunk as is
-        if (I2C_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
-            print("oled_render data failed\n");
-            return;
-        }
-    } else {
-        // Rotate the render chunks
-        const static uint8_t source_map[] = OLED_SOURCE_MAP;
-        const static uint8_t target_map[] = OLED_TARGET_MAP;
-
-        static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-        memset(temp_buffer, 0, sizeof(temp_buffer));
-        for (uint8_t i = 0; i < sizeof(source_map); ++i) {
-            rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
+    // Do we have work to do?
+    oled_dirty &= OLED_ALL_BLOCKS_MASK;
+    if (!oled_dirty || oled_scrolling) {
+        return;
+    }
+
+    // Flush dirty blocks until the budget is spent, always at least one
+    uint16_t sent = 0;
+    do {
+        // Find first dirty block
+        uint8_t first = 0;
+        while (!(oled_dirty & OLED_BLOCK_BIT(first))) {
+            ++first;
         }
 
-        // Send render data chunk after rotating
-        if (I2C_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
-            print("oled_render90 data failed\n");
+        uint8_t last = first;
+        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+            // Merge the dirty blocks that follow it into one range
+            while (last + 1 < OLED_BLOCK_COUNT && (oled_dirty & OLED_BLOCK_BIT(last + 1)) && (last + 2 - first) * OLED_BLOCK_SIZE <= OLED_RENDER_RANGE_MAX_BYTES &&
+                   sent + (last + 2 - first) * OLED_BLOCK_SIZE + oled_range_transfers(OLED_BLOCK_SIZE * first, OLED_BLOCK_SIZE * (last + 2)) * OLED_TRANSFER_OVERHEAD <= OLED_RENDER_BUDGET_BYTES) {
+                ++last;
+            }
+            if (!oled_render_range(OLED_BLOCK_SIZE * first, OLED_BLOCK_SIZE * (last + 1), &sent)) {
+                return;
+            }
+        } else if (!oled_render_block_90(first, &sent)) {
             return;
         }
-    }
+
+        // Clear dirty flags
+        for (uint8_t block = first; block <= last; ++block) {
+            oled_dirty &= ~OLED_BLOCK_BIT(block);
+#ifdef OLED_RENDER_SHADOW
+            oled_shadow_stale &= ~OLED_BLOCK_BIT(block);
+#endif
+        }
+    } while (oled_dirty && sent + OLED_BLOCK_SIZE + OLED_TRANSFER_OVERHEAD <= OLED_RENDER_BUDGET_BYTES);
 
     // Turn on display if it is off
     oled_on();
-
-    // Clear dirty flag
-    oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
 }
 
 void oled_set_cursor(uint8_t col, uint8_t line) {
@@ -698,6 +862,10 @@ bool oled_scroll_off(void) {
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#ifdef OLED_RENDER_SHADOW
+        // Scrolling moved the display RAM contents
+        oled_shadow_stale = OLED_ALL_BLOCKS_MASK;
+#endif
     }
     return !oled_scrolling;
 }
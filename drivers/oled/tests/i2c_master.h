@@ -0,0 +1,48 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Stand-in for the platform i2c_master.h, implemented by mock_i2c.c */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+void         i2c_init(void);
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout);
+void         i2c_stop(void);
+
+#ifdef I2C_ASYNC_ENABLE
+typedef void (*i2c_async_callback_t)(i2c_status_t status);
+
+/* Largest packet, register address included, a single asynchronous transaction can send */
+#    ifndef I2C_ASYNC_BUFFER_SIZE
+#        define I2C_ASYNC_BUFFER_SIZE 512
+#    endif
+
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback);
+i2c_status_t i2c_writeReg_async(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback);
+bool         i2c_async_busy(void);
+void         i2c_async_wait(void);
+void         i2c_async_task(void);
+#endif
@@ -0,0 +1,199 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "i2c_master.h"
+#include "mock_i2c.h"
+
+#define COLUMN_ADDR 0x21
+#define PAGE_ADDR 0x22
+#define I2C_DATA 0x40
+
+uint8_t mock_i2c_display[OLED_MATRIX_SIZE];
+
+uint32_t mock_i2c_transfers;
+uint32_t mock_i2c_bytes;
+uint32_t mock_i2c_data_transfers;
+bool     mock_i2c_fail_next;
+
+static uint8_t column_start, column_end, page_start, page_end;
+static uint8_t column, page;
+
+#ifdef I2C_ASYNC_ENABLE
+#    define MOCK_I2C_ASYNC_QUEUE_SIZE 16
+
+typedef struct {
+    bool                 write_reg;
+    uint8_t              regaddr;
+    uint8_t              data[OLED_MATRIX_SIZE];
+    uint16_t             length;
+    i2c_async_callback_t callback;
+    i2c_status_t         status;
+} mock_i2c_transaction_t;
+
+static mock_i2c_transaction_t async_queue[MOCK_I2C_ASYNC_QUEUE_SIZE];
+// [retired, sent) wait for their callback, [sent, queued) for the bus
+static uint8_t async_queued, async_sent, async_retired;
+#endif
+
+void mock_i2c_reset(void) {
+    memset(mock_i2c_display, 0, sizeof(mock_i2c_display));
+    mock_i2c_transfers      = 0;
+    mock_i2c_bytes          = 0;
+    mock_i2c_data_transfers = 0;
+    mock_i2c_fail_next      = false;
+#ifdef I2C_ASYNC_ENABLE
+    async_queued = async_sent = async_retired = 0;
+#endif
+    column_start = column = 0;
+    column_end            = OLED_DISPLAY_WIDTH - 1;
+    page_start = page = 0;
+    page_end          = OLED_DISPLAY_HEIGHT / 8 - 1;
+}
+
+static bool mock_i2c_start(uint16_t length) {
+    mock_i2c_transfers++;
+    mock_i2c_bytes += 1 + length;
+    if (mock_i2c_fail_next) {
+        mock_i2c_fail_next = false;
+        return false;
+    }
+    return true;
+}
+
+#ifdef I2C_ASYNC_ENABLE
+static i2c_status_t mock_i2c_transmit(const uint8_t *data, uint16_t length);
+static i2c_status_t mock_i2c_writeReg(uint8_t regaddr, const uint8_t *data, uint16_t length);
+
+static i2c_status_t mock_i2c_submit(bool write_reg, uint8_t regaddr, const uint8_t *data, uint16_t length, i2c_async_callback_t callback) {
+    if (length > OLED_MATRIX_SIZE || (write_reg ? 1 : 0) + length > I2C_ASYNC_BUFFER_SIZE) {
+        return I2C_STATUS_ERROR;
+    }
+    if (async_queued == MOCK_I2C_ASYNC_QUEUE_SIZE) {
+        // The real queue waits for room
+        mock_i2c_run_async();
+        i2c_async_task();
+    }
+
+    mock_i2c_transaction_t *transaction = &async_queue[async_queued++];
+    transaction->write_reg              = write_reg;
+    transaction->regaddr                = regaddr;
+    transaction->length                 = length;
+    transaction->callback               = callback;
+    memcpy(transaction->data, data, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+void mock_i2c_run_async(void) {
+    while (async_sent < async_queued) {
+        mock_i2c_transaction_t *transaction = &async_queue[async_sent++];
+        if (transaction->write_reg) {
+            transaction->status = mock_i2c_writeReg(transaction->regaddr, transaction->data, transaction->length);
+        } else {
+            transaction->status = mock_i2c_transmit(transaction->data, transaction->length);
+        }
+    }
+}
+
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback) {
+    return mock_i2c_submit(false, 0, data, length, callback);
+}
+
+i2c_status_t i2c_writeReg_async(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback) {
+    return mock_i2c_submit(true, regaddr, data, length, callback);
+}
+
+bool i2c_async_busy(void) {
+    return async_sent != async_queued;
+}
+
+void i2c_async_wait(void) {
+    mock_i2c_run_async();
+}
+
+void i2c_async_task(void) {
+    while (async_retired < async_sent) {
+        mock_i2c_transaction_t *transaction = &async_queue[async_retired++];
+        if (transaction->callback) {
+            transaction->callback(transaction->status);
+        }
+    }
+    if (async_retired == async_queued) {
+        async_queued = async_sent = async_retired = 0;
+    }
+}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
+    return mock_i2c_transmit(data, length);
+}
+
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
+    return mock_i2c_writeReg(regaddr, data, length);
+}
+#endif
+
+void i2c_init(void) {}
+
+void i2c_stop(void) {}
+
+/* Commands: only the addressing ones matter to the emulated display */
+#ifdef I2C_ASYNC_ENABLE
+static i2c_status_t mock_i2c_transmit(const uint8_t *data, uint16_t length) {
+#else
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+#endif
+    if (!mock_i2c_start(length)) {
+        return I2C_STATUS_ERROR;
+    }
+    for (uint16_t i = 1; i < length; i++) {
+        if (data[i] == COLUMN_ADDR && i + 2 < length) {
+            column_start = column = data[i + 1];
+            column_end            = data[i + 2];
+            i += 2;
+        } else if (data[i] == PAGE_ADDR && i + 2 < length) {
+            page_start = page = data[i + 1];
+            page_end          = data[i + 2];
+            i += 2;
+        }
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+/* Display data, written at the address pointer which wraps inside the column and page window */
+#ifdef I2C_ASYNC_ENABLE
+static i2c_status_t mock_i2c_writeReg(uint8_t regaddr, const uint8_t *data, uint16_t length) {
+#else
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+#endif
+    if (!mock_i2c_start(1 + length)) {
+        return I2C_STATUS_ERROR;
+    }
+    if (regaddr != I2C_DATA) {
+        return I2C_STATUS_SUCCESS;
+    }
+    mock_i2c_data_transfers++;
+    for (uint16_t i = 0; i < length; i++) {
+        mock_i2c_display[page * OLED_DISPLAY_WIDTH + column] = data[i];
+        if (column++ == column_end) {
+            column = column_start;
+            page   = page == page_end ? page_start : page + 1;
+        }
+    }
+    return I2C_STATUS_SUCCESS;
+}
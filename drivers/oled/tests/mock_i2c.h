@@ -0,0 +1,37 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "oled_driver.h"
+
+/* Emulated SSD1306 behind the mock bus, in horizontal addressing mode */
+extern uint8_t mock_i2c_display[OLED_MATRIX_SIZE];
+
+extern uint32_t mock_i2c_transfers;      // number of I2C transfers, each start to stop
+extern uint32_t mock_i2c_bytes;          // bytes on the bus, address bytes included
+extern uint32_t mock_i2c_data_transfers; // transfers carrying display data
+extern bool     mock_i2c_fail_next;      // makes the next transfer fail
+
+void mock_i2c_reset(void);
+
+#ifdef I2C_ASYNC_ENABLE
+/* Sends the queued asynchronous transactions, as the background thread would */
+void mock_i2c_run_async(void);
+#endif
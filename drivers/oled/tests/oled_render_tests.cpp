@@ -0,0 +1,194 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "oled_driver.h"
+#include "i2c_master.h"
+#include "mock_i2c.h"
+
+extern OLED_BLOCK_TYPE oled_dirty;
+
+bool is_keyboard_master(void) {
+    return true;
+}
+}
+
+class OledRender : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        oled_init(OLED_ROTATION_0);
+        mock_i2c_reset();
+    }
+
+    /* Lets the queued transfers go out and delivers their results, as the next keyboard task would */
+    void pump(void) {
+#ifdef I2C_ASYNC_ENABLE
+        mock_i2c_run_async();
+        i2c_async_task();
+#endif
+    }
+
+    void render(void) {
+        oled_render();
+        pump();
+    }
+
+    /* Renders until nothing is dirty, returns the number of oled_render() calls it took */
+    uint32_t flush(void) {
+        uint32_t calls = 0;
+        while (oled_dirty && calls < 1000) {
+            render();
+            calls++;
+        }
+        return calls;
+    }
+
+    bool display_matches_buffer(void) {
+        return memcmp(mock_i2c_display, oled_read_raw(0).current_element, OLED_MATRIX_SIZE) == 0;
+    }
+
+    /* A status screen as commonly drawn from oled_task_user(), redrawn from scratch every time */
+    void draw_status(const char *layer, uint8_t wpm, bool caps) {
+        char wpm_str[4] = {(char)('0' + wpm / 100 % 10), (char)('0' + wpm / 10 % 10), (char)('0' + wpm % 10), 0};
+
+        oled_clear();
+        oled_write("Layer: ", false);
+        oled_write_ln(layer, false);
+        oled_write("WPM: ", false);
+        oled_write_ln(wpm_str, false);
+        oled_write_ln(caps ? "CAPS" : "    ", caps);
+    }
+
+    void print_cost(const char *name) {
+        std::cout << "[ OLED     ] " << name << ": " << mock_i2c_bytes << " bytes in " << mock_i2c_transfers << " transfers" << std::endl;
+    }
+
+    void reset_counters(void) {
+        mock_i2c_transfers      = 0;
+        mock_i2c_bytes          = 0;
+        mock_i2c_data_transfers = 0;
+    }
+};
+
+TEST_F(OledRender, FullRedrawReachesTheDisplay) {
+    for (uint16_t i = 0; i < OLED_MATRIX_SIZE; i++) {
+        oled_write_raw_byte(i * 7 + 1, i);
+    }
+    flush();
+
+    EXPECT_TRUE(display_matches_buffer());
+    // Adjacent dirty blocks are merged, a whole page per transfer at most
+    EXPECT_LT(mock_i2c_data_transfers, OLED_BLOCK_COUNT);
+    print_cost("full redraw");
+}
+
+TEST_F(OledRender, RenderStaysWithinBudget) {
+    for (uint16_t i = 0; i < OLED_MATRIX_SIZE; i++) {
+        oled_write_raw_byte(0xA5, i);
+    }
+
+    while (oled_dirty) {
+        reset_counters();
+        render();
+        EXPECT_LE(mock_i2c_bytes, OLED_RENDER_BUDGET_US / OLED_I2C_BYTE_US);
+    }
+    EXPECT_TRUE(display_matches_buffer());
+}
+
+TEST_F(OledRender, StatusScreenRedrawsOnlyWhatChanged) {
+    draw_status("Base", 42, false);
+    flush();
+    EXPECT_TRUE(display_matches_buffer());
+
+    reset_counters();
+    draw_status("Base", 42, false);
+    flush();
+#ifdef OLED_RENDER_SHADOW
+    EXPECT_EQ(mock_i2c_data_transfers, 0);
+#endif
+    print_cost("unchanged status screen");
+
+    reset_counters();
+    draw_status("Base", 43, false);
+    flush();
+    EXPECT_TRUE(display_matches_buffer());
+#ifdef OLED_RENDER_SHADOW
+    // one glyph
+    EXPECT_EQ(mock_i2c_data_transfers, 1);
+    EXPECT_LE(mock_i2c_bytes, OLED_FONT_WIDTH + 10);
+#endif
+    print_cost("status screen, WPM changed");
+
+    reset_counters();
+    draw_status("Lower", 43, true);
+    flush();
+    EXPECT_TRUE(display_matches_buffer());
+    print_cost("status screen, layer and caps changed");
+}
+
+TEST_F(OledRender, FailedTransferIsRetried) {
+    flush();
+    oled_write_raw_byte(0x5A, OLED_DISPLAY_WIDTH + 3);
+
+    mock_i2c_fail_next = true;
+    render();
+    EXPECT_TRUE(oled_dirty);
+    EXPECT_FALSE(display_matches_buffer());
+
+    flush();
+    EXPECT_TRUE(display_matches_buffer());
+}
+
+#ifdef I2C_ASYNC_ENABLE
+TEST_F(OledRender, AsyncRenderDoesNotWaitForTheBus) {
+    draw_status("Base", 42, false);
+
+    oled_render();
+    EXPECT_TRUE(i2c_async_busy());
+    EXPECT_EQ(mock_i2c_transfers, 0);
+
+    pump();
+    EXPECT_FALSE(i2c_async_busy());
+    EXPECT_GT(mock_i2c_data_transfers, 0);
+}
+
+TEST_F(OledRender, AsyncRenderSendsTheBufferAsQueued) {
+    oled_write_raw_byte(0x11, 5);
+    oled_render();
+
+    // Drawing on while the transfer waits for the bus must not tear it
+    oled_write_raw_byte(0x22, 5);
+    pump();
+    EXPECT_EQ(mock_i2c_display[5], 0x11);
+
+    flush();
+    EXPECT_EQ(mock_i2c_display[5], 0x22);
+    EXPECT_TRUE(display_matches_buffer());
+}
+
+TEST_F(OledRender, BlockingCommandsWaitForQueuedTransfers) {
+    oled_write_raw_byte(0x33, 7);
+    oled_render();
+    EXPECT_TRUE(i2c_async_busy());
+
+    oled_off();
+    EXPECT_FALSE(i2c_async_busy());
+    EXPECT_EQ(mock_i2c_display[7], 0x33);
+}
+#endif
@@ -0,0 +1,22 @@
+oled_render_DEFS := -DOLED_ENABLE -DNO_PRINT -DNO_DEBUG -DOLED_TIMEOUT=0 -DOLED_SCROLL_TIMEOUT=0 -DOLED_RENDER_BUDGET_US=2000 -DOLED_I2C_BYTE_US=23
+
+oled_render_INC := $(DRIVER_PATH)/oled/tests $(DRIVER_PATH)/oled
+
+oled_render_SRC := \
+	$(DRIVER_PATH)/oled/tests/mock_i2c.c \
+	$(DRIVER_PATH)/oled/tests/oled_render_tests.cpp \
+	$(DRIVER_PATH)/oled/ssd1306_sh1106.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+oled_render_shadow_DEFS := $(oled_render_DEFS) -DOLED_RENDER_SHADOW
+oled_render_shadow_INC := $(oled_render_INC)
+oled_render_shadow_SRC := $(oled_render_SRC)
+
+oled_render_async_DEFS := $(oled_render_DEFS) -DOLED_RENDER_SHADOW -DI2C_ASYNC_ENABLE
+oled_render_async_INC := $(oled_render_INC)
+oled_render_async_SRC := $(oled_render_SRC)
+
+# The budget allows merging more blocks into one range than the queue can hold in one packet
+oled_render_async_small_DEFS := $(oled_render_async_DEFS) -UOLED_RENDER_BUDGET_US -DOLED_RENDER_BUDGET_US=5000 -DI2C_ASYNC_BUFFER_SIZE=100
+oled_render_async_small_INC := $(oled_render_INC)
+oled_render_async_small_SRC := $(oled_render_SRC)
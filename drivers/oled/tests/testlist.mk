@@ -0,0 +1 @@
+TEST_LIST += oled_render oled_render_shadow oled_render_async oled_render_async_small
@@ -27,3 +27,17 @@ void soft_serial_initiator_init(void);
 void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+// initiator starts a transaction without waiting for it to complete
+bool soft_serial_transaction_begin(int sstd_index);
+// initiator checks on the transaction started last
+transport_status_t soft_serial_transaction_poll(void);
+#endif
+
+#ifdef SERIAL_USART_PUSH
+// target sends the target2initiator buffer of a transaction without being asked
+bool soft_serial_target_push(int sstd_index);
+// initiator collects buffers pushed by the target, returns the bitmask of transactions received since the last call
+uint32_t soft_serial_initiator_pushed(void);
+#endif
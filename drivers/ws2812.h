@@ -68,3 +68,13 @@
  *         - Wait 50us to reset the LEDs
  */
 void ws2812_setleds(LED_TYPE *ledarray, uint16_t number_of_leds);
+
+#ifdef WS2812_DRIVER_PWM_ASYNC
+/* Non-blocking driver only
+ *
+ * ws2812_setleds() returns before the LEDs are updated. This returns true when
+ * another frame can be passed to ws2812_setleds() without replacing a frame
+ * that has not been sent yet.
+ */
+bool ws2812_ready(void);
+#endif
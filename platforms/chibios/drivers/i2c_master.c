@@ -119,6 +119,167 @@ static i2c_status_t chibios_to_qmk(const msg_t* status) {
     }
 }
 
+#ifdef I2C_ASYNC_ENABLE
+#    ifndef I2C_ASYNC_QUEUE_SIZE
+#        define I2C_ASYNC_QUEUE_SIZE 16
+#    endif
+#    if (I2C_ASYNC_QUEUE_SIZE & (I2C_ASYNC_QUEUE_SIZE - 1)) != 0 || I2C_ASYNC_QUEUE_SIZE > 128
+#        error "I2C_ASYNC_QUEUE_SIZE must be a power of two no larger than 128"
+#    endif
+
+typedef struct {
+    uint8_t              address;
+    uint16_t             start; // of the packet in i2c_async_buffer
+    uint16_t             length;
+    uint16_t             timeout;
+    i2c_async_callback_t callback;
+    i2c_status_t         status;
+} i2c_async_transaction_t;
+
+#    define I2C_ASYNC_QUEUE_ENTRY(index) (&i2c_async_queue[(index) & (I2C_ASYNC_QUEUE_SIZE - 1)])
+
+static i2c_async_transaction_t i2c_async_queue[I2C_ASYNC_QUEUE_SIZE];
+static uint8_t                 i2c_async_buffer[I2C_ASYNC_BUFFER_SIZE];
+static uint16_t                i2c_async_buffer_head = 0;
+// Free running indices: [tail, done) wait for their callback, [done, head) for the bus
+static uint8_t          i2c_async_tail = 0;
+static volatile uint8_t i2c_async_done = 0;
+static uint8_t          i2c_async_head = 0;
+static bool             i2c_async_started = false;
+static SEMAPHORE_DECL(i2c_async_pending, 0);
+static BSEMAPHORE_DECL(i2c_async_progress, true);
+
+/**
+ * @brief This thread sends the queued transactions one after the other. It
+ * sleeps while the driver moves the bytes, so the main loop keeps running.
+ */
+static THD_WORKING_AREA(waI2CAsyncThread, 256);
+static THD_FUNCTION(I2CAsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chSemWait(&i2c_async_pending);
+
+        i2c_async_transaction_t* transaction = I2C_ASYNC_QUEUE_ENTRY(i2c_async_done);
+        i2cStart(&I2C_DRIVER, &i2cconfig);
+        msg_t status        = i2cMasterTransmitTimeout(&I2C_DRIVER, (transaction->address >> 1), &i2c_async_buffer[transaction->start], transaction->length, 0, 0, TIME_MS2I(transaction->timeout));
+        transaction->status = chibios_to_qmk(&status);
+
+        i2c_async_done++;
+        chBSemSignal(&i2c_async_progress);
+    }
+}
+
+/* Finds room for a packet, the packets of transactions still waiting for the bus are kept. */
+static bool i2c_async_alloc(uint16_t length, uint16_t* start) {
+    uint8_t done = i2c_async_done;
+
+    if ((uint8_t)(i2c_async_head - i2c_async_tail) >= I2C_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+    if (done == i2c_async_head) {
+        *start = 0;
+        return true;
+    }
+
+    uint16_t used = I2C_ASYNC_QUEUE_ENTRY(done)->start;
+    if (i2c_async_buffer_head > used) {
+        if (I2C_ASYNC_BUFFER_SIZE - i2c_async_buffer_head >= length) {
+            *start = i2c_async_buffer_head;
+            return true;
+        }
+        if (used >= length) {
+            *start = 0;
+            return true;
+        }
+    } else if (used - i2c_async_buffer_head >= length) {
+        *start = i2c_async_buffer_head;
+        return true;
+    }
+    return false;
+}
+
+static i2c_status_t i2c_async_submit(uint8_t address, const uint8_t* reg, uint8_t reg_length, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback) {
+    uint16_t packet_length = reg_length + length;
+    if (packet_length > I2C_ASYNC_BUFFER_SIZE) {
+        return I2C_STATUS_ERROR;
+    }
+
+    if (!i2c_async_started) {
+        i2c_async_started = true;
+        /* Above the main loop, so the next transaction starts as soon as the bus is free. */
+        chThdCreateStatic(waI2CAsyncThread, sizeof(waI2CAsyncThread), NORMALPRIO + 1, I2CAsyncThread, NULL);
+    }
+
+    uint16_t start;
+    while (!i2c_async_alloc(packet_length, &start)) {
+        if (i2c_async_tail != i2c_async_done) {
+            // Finished transactions give up their slot once their callback ran
+            i2c_async_task();
+        } else {
+            chBSemWait(&i2c_async_progress);
+        }
+    }
+
+    if (reg_length) {
+        memcpy(&i2c_async_buffer[start], reg, reg_length);
+    }
+    memcpy(&i2c_async_buffer[start + reg_length], data, length);
+    i2c_async_buffer_head = start + packet_length;
+
+    i2c_async_transaction_t* transaction = I2C_ASYNC_QUEUE_ENTRY(i2c_async_head);
+    transaction->address                 = address;
+    transaction->start                   = start;
+    transaction->length                  = packet_length;
+    transaction->timeout                 = timeout;
+    transaction->callback                = callback;
+    i2c_async_head++;
+
+    chSemSignal(&i2c_async_pending);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback) {
+    return i2c_async_submit(address, NULL, 0, data, length, timeout, callback);
+}
+
+i2c_status_t i2c_writeReg_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback) {
+    return i2c_async_submit(devaddr, &regaddr, 1, data, length, timeout, callback);
+}
+
+bool i2c_async_busy(void) {
+    return i2c_async_done != i2c_async_head;
+}
+
+void i2c_async_wait(void) {
+    while (i2c_async_busy()) {
+        chBSemWait(&i2c_async_progress);
+    }
+}
+
+void i2c_async_task(void) {
+    while (i2c_async_tail != i2c_async_done) {
+        i2c_async_transaction_t* transaction = I2C_ASYNC_QUEUE_ENTRY(i2c_async_tail);
+        i2c_async_callback_t     callback    = transaction->callback;
+        i2c_status_t             status      = transaction->status;
+
+        // Free the slot first, the callback may submit again
+        i2c_async_tail++;
+        if (callback) {
+            callback(status);
+        }
+    }
+}
+#endif
+
+/* Blocking transactions go out after the queued ones. */
+static inline void i2c_async_drain(void) {
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_wait();
+#endif
+}
+
 __attribute__((weak)) void i2c_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -140,12 +301,14 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_start(uint8_t address) {
+    i2c_async_drain();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     return I2C_STATUS_SUCCESS;
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
@@ -153,6 +316,7 @@ i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length,
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, TIME_MS2I(timeout));
@@ -160,6 +324,7 @@ i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16
 }
 
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -174,6 +339,7 @@ i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data,
 }
 
 i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -189,6 +355,7 @@ i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* da
 }
 
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
@@ -196,6 +363,7 @@ i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16
 }
 
 i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
@@ -204,5 +372,6 @@ i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uin
 }
 
 void i2c_stop(void) {
+    i2c_async_drain();
     i2cStop(&I2C_DRIVER);
 }
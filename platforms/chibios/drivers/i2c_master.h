@@ -25,6 +25,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 typedef int16_t i2c_status_t;
 
@@ -41,3 +42,22 @@ i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* da
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 void         i2c_stop(void);
+
+#ifdef I2C_ASYNC_ENABLE
+/* Asynchronous transactions are copied into a queue and sent by a background
+ * thread, in the order they were submitted. The blocking functions above wait
+ * for the queue to drain first. Callbacks run from i2c_async_task().
+ */
+typedef void (*i2c_async_callback_t)(i2c_status_t status);
+
+/* Largest packet, register address included, a single asynchronous transaction can send */
+#    ifndef I2C_ASYNC_BUFFER_SIZE
+#        define I2C_ASYNC_BUFFER_SIZE 512
+#    endif
+
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback);
+i2c_status_t i2c_writeReg_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback);
+bool         i2c_async_busy(void);
+void         i2c_async_wait(void);
+void         i2c_async_task(void);
+#endif
@@ -34,10 +34,20 @@ static SerialConfig serial_config = {
 static SerialDriver* serial_driver = &SERIAL_USART_DRIVER;
 
 static inline bool react_to_transactions(void);
+static inline bool respond_to_transaction(uint8_t sstd_index);
 static inline bool __attribute__((nonnull)) receive(uint8_t* destination, const size_t size);
 static inline bool __attribute__((nonnull)) send(const uint8_t* source, const size_t size);
 static inline bool initiate_transaction(uint8_t sstd_index);
+static inline bool run_transaction(uint8_t sstd_index);
 static inline void usart_clear(void);
+static inline bool receive_handshake(uint8_t* shake);
+
+#if defined(SERIAL_USART_PUSH)
+/* Serializes pushes from the main loop with the slave thread's replies. */
+static MUTEX_DECL(send_mutex);
+/* Bitmask of transactions whose buffer was pushed since the last soft_serial_initiator_pushed() call. */
+static uint32_t pushed = 0;
+#endif
 
 /**
  * @brief Clear the receive input queue.
@@ -195,6 +205,21 @@ static inline bool react_to_transactions(void) {
     /* Wait until there is a transaction for us. */
     uint8_t sstd_index = (uint8_t)sdGet(serial_driver);
 
+#if defined(SERIAL_USART_PUSH)
+    /* Wait for a push in progress to finish, its bytes must not interleave with the reply. */
+    chMtxLock(&send_mutex);
+    bool success = respond_to_transaction(sstd_index);
+    chMtxUnlock(&send_mutex);
+    return success;
+#else
+    return respond_to_transaction(sstd_index);
+#endif
+}
+
+/**
+ * @brief Exchange the buffers of a transaction started by the master.
+ */
+static inline bool respond_to_transaction(uint8_t sstd_index) {
     /* Sanity check that we are actually responding to a valid transaction. */
     if (sstd_index >= NUM_TOTAL_TRANSACTIONS) {
         return false;
@@ -231,6 +256,116 @@ static inline bool react_to_transactions(void) {
     return true;
 }
 
+#if defined(SERIAL_USART_PUSH)
+
+/**
+ * @brief Send the target2initiator buffer of a transaction to the master
+ * without waiting to be asked, e.g. as soon as the slave matrix changes.
+ *
+ * @param index Transaction Table index of the buffer to push.
+ * @return bool Indicates success of the push.
+ */
+bool soft_serial_target_push(int index) {
+    if (index < 0 || index >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+
+    split_transaction_desc_t* trans     = &split_transaction_table[index];
+    uint8_t                   header[2] = {PUSH_MAGIC, (uint8_t)index};
+
+    chMtxLock(&send_mutex);
+    bool success = send(header, sizeof(header)) && send(split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+    chMtxUnlock(&send_mutex);
+
+    return success;
+}
+
+/**
+ * @brief Receive the rest of a pushed buffer, after its start byte.
+ */
+static inline bool receive_push(void) {
+    uint8_t sstd_index;
+    if (!receive(&sstd_index, sizeof(sstd_index)) || sstd_index >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+
+    split_transaction_desc_t* trans = &split_transaction_table[sstd_index];
+    if (!trans->target2initiator_buffer_size || !receive(split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size)) {
+        return false;
+    }
+
+    pushed |= (1UL << sstd_index);
+    return true;
+}
+
+/**
+ * @brief Empty the receive queue without blocking, keeping pushed buffers
+ * and discarding parts of failed transactions or spurious bytes.
+ */
+static inline void receive_pushes(void) {
+    msg_t start;
+    while ((start = sdGetTimeout(serial_driver, TIME_IMMEDIATE)) != MSG_TIMEOUT) {
+        if (start == PUSH_MAGIC && !receive_push()) {
+            dprintln("USART: Receive push failed.");
+        }
+    }
+}
+
+/**
+ * @brief Collect buffers pushed by the slave half.
+ *
+ * @return uint32_t Bitmask of the transactions whose buffer arrived since the last call.
+ */
+uint32_t soft_serial_initiator_pushed(void) {
+    receive_pushes();
+    uint32_t received = pushed;
+    pushed            = 0;
+    return received;
+}
+
+#endif
+
+/**
+ * @brief Receive the handshake of a transaction, taking in buffers the
+ * slave pushed just before it.
+ */
+static inline bool receive_handshake(uint8_t* shake) {
+    while (receive(shake, sizeof(*shake))) {
+#if defined(SERIAL_USART_PUSH)
+        if (*shake == PUSH_MAGIC) {
+            receive_push();
+            continue;
+        }
+#endif
+        return true;
+    }
+    return false;
+}
+
+#if defined(SPLIT_TRANSPORT_ASYNC)
+
+static BSEMAPHORE_DECL(transaction_start, true);
+static volatile uint8_t            transaction_index  = 0;
+static volatile transport_status_t transaction_status = TRANSPORT_IDLE;
+
+/**
+ * @brief This thread runs on the master and carries out the transactions
+ * started with soft_serial_transaction_begin(), so that the master can keep
+ * scanning while the bytes are on the wire.
+ */
+static THD_WORKING_AREA(waMasterThread, 256);
+static THD_FUNCTION(MasterThread, arg) {
+    (void)arg;
+    chRegSetThreadName("usart_master");
+
+    while (true) {
+        chBSemWait(&transaction_start);
+        transaction_status = run_transaction(transaction_index) ? TRANSPORT_SUCCESS : TRANSPORT_FAILED;
+    }
+}
+
+#endif
+
 /**
  * @brief Master specific initializations.
  */
@@ -242,6 +377,11 @@ void soft_serial_initiator_init(void) {
 #endif
 
     sdStart(serial_driver, &serial_config);
+
+#if defined(SPLIT_TRANSPORT_ASYNC)
+    /* Start transport thread, above the main loop so it picks up bytes as soon as they arrive. */
+    chThdCreateStatic(waMasterThread, sizeof(waMasterThread), NORMALPRIO + 1, MasterThread, NULL);
+#endif
 }
 
 /**
@@ -251,10 +391,64 @@ void soft_serial_initiator_init(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#if defined(SPLIT_TRANSPORT_ASYNC)
+    /* Let the transaction in flight finish first, its result stays available for polling. */
+    while (transaction_status == TRANSPORT_PENDING) {
+        chThdSleepMilliseconds(1);
+    }
+#endif
+    return run_transaction((uint8_t)index);
+}
+
+#if defined(SPLIT_TRANSPORT_ASYNC)
+
+/**
+ * @brief Start transaction from the master half to the slave half, without
+ * waiting for it to complete. The transaction buffers must be left alone
+ * until soft_serial_transaction_poll() no longer reports it as pending.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool false if the previous transaction is still pending.
+ */
+bool soft_serial_transaction_begin(int index) {
+    if (transaction_status == TRANSPORT_PENDING) {
+        return false;
+    }
+
+    transaction_index  = (uint8_t)index;
+    transaction_status = TRANSPORT_PENDING;
+    chBSemSignal(&transaction_start);
+    return true;
+}
+
+/**
+ * @brief Check on the transaction started last.
+ *
+ * @return transport_status_t Success or failure is reported once, after that the driver is idle.
+ */
+transport_status_t soft_serial_transaction_poll(void) {
+    transport_status_t status = transaction_status;
+    if (status != TRANSPORT_PENDING) {
+        transaction_status = TRANSPORT_IDLE;
+    }
+    return status;
+}
+
+#endif
+
+/**
+ * @brief Run a transaction to the slave half, blocking until it completes.
+ */
+static inline bool run_transaction(uint8_t sstd_index) {
+#if defined(SERIAL_USART_PUSH)
+    /* Collect buffers the slave pushed in the meantime, anything else is dropped. */
+    receive_pushes();
+#else
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     usart_clear();
-    return initiate_transaction((uint8_t)index);
+#endif
+    return initiate_transaction(sstd_index);
 }
 
 /**
@@ -281,7 +475,7 @@ static inline bool initiate_transaction(uint8_t sstd_index) {
      *   - due to the half duplex limitations on return codes, we always have to read *something*.
      *   - without the read, write only transactions *always* succeed, even during the boot process where the slave is not ready.
      */
-    if (!receive(&sstd_index_shake, sizeof(sstd_index_shake)) || (sstd_index_shake != (sstd_index ^ HANDSHAKE_MAGIC))) {
+    if (!receive_handshake(&sstd_index_shake) || (sstd_index_shake != (sstd_index ^ HANDSHAKE_MAGIC))) {
         dprintln("USART: Handshake failed.");
         return false;
     }
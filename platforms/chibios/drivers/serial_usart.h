@@ -114,3 +114,11 @@
 #endif
 
 #define HANDSHAKE_MAGIC 7
+
+#if defined(SERIAL_USART_PUSH)
+#    if !defined(SERIAL_USART_FULL_DUPLEX)
+#        error "SERIAL_USART_PUSH requires SERIAL_USART_FULL_DUPLEX"
+#    endif
+/* Start byte of a buffer pushed by the slave, never a valid handshake. */
+#    define PUSH_MAGIC 0xA5
+#endif
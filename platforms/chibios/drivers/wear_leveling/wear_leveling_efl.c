@@ -0,0 +1,37 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdbool.h>
+#include <hal.h>
+#include "flash_stm32.h"
+#include "wear_leveling.h"
+#include "wear_leveling_internal.h"
+
+#define BACKING_STORE_ADDRESS(address) ((uintptr_t)(FEE_PAGE_BASE_ADDRESS) + (address))
+
+bool backing_store_init(void) {
+    return true;
+}
+
+bool backing_store_unlock(void) {
+    FLASH_Unlock();
+    return true;
+}
+
+bool backing_store_erase(uint32_t address) {
+    return FLASH_ErasePage(BACKING_STORE_ADDRESS(address)) == FLASH_COMPLETE;
+}
+
+bool backing_store_write(uint32_t address, uint16_t value) {
+    return FLASH_ProgramHalfWord(BACKING_STORE_ADDRESS(address), value) == FLASH_COMPLETE;
+}
+
+bool backing_store_lock(void) {
+    FLASH_Lock();
+    return true;
+}
+
+bool backing_store_read(uint32_t address, uint16_t *value) {
+    *value = *(__IO uint16_t *)BACKING_STORE_ADDRESS(address);
+    return true;
+}
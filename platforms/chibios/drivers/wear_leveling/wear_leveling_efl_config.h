@@ -0,0 +1,20 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Reuses the flash area and page geometry of the emulated EEPROM driver
+#include "eeprom_stm32_defs.h"
+
+#define BACKING_STORE_ERASE_SIZE FEE_PAGE_SIZE
+
+#ifndef WEAR_LEVELING_BACKING_SIZE
+#    if FEE_PAGE_COUNT < 2
+#        error wear leveling: the embedded flash backing store needs FEE_PAGE_COUNT of at least 2
+#    endif
+#    define WEAR_LEVELING_BACKING_SIZE ((FEE_PAGE_COUNT / 2) * 2 * FEE_PAGE_SIZE)
+#endif
+
+#ifndef WEAR_LEVELING_LOGICAL_SIZE
+#    define WEAR_LEVELING_LOGICAL_SIZE (WEAR_LEVELING_BACKING_SIZE / 4)
+#endif
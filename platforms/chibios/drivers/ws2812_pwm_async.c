@@ -0,0 +1,149 @@
+#include "ws2812_pwm.h"
+
+/* Non-blocking variant of ws2812_pwm.c
+ *
+ * ws2812_setleds() encodes the frame into one of two buffers and hands it to a
+ * one-shot DMA transfer, returning immediately. While one buffer is being sent,
+ * the next frame is encoded into the other one and queued; the DMA completion
+ * interrupt starts it. ws2812_ready() tells whether another frame can be queued
+ * without replacing one that has not been sent yet.
+ */
+
+#if WS2812_BIT_N + 1 > 65535
+#    error "Too many LEDs for a single DMA transfer"
+#endif
+
+/* --- PRIVATE VARIABLES ---------------------------------------------------- */
+
+/**
+ * @brief   Frame buffers, one being sent while the other one is filled
+ *
+ * Each frame ends with the reset bits and a final zero duty cycle, which keeps
+ * the line low after the transfer. Half words are enough for the duty cycles
+ * and halve the memory needed for the second buffer.
+ */
+static uint16_t ws2812_frame_buffer[2][WS2812_BIT_N + 1];
+
+static uint16_t          ws2812_frame_length[2]; /**< Number of duty cycles to send from each buffer */
+static uint8_t           ws2812_back    = 0;     /**< Buffer that the next frame is written to */
+static volatile bool     ws2812_sending = false; /**< A frame is being sent */
+static volatile bool     ws2812_pending = false; /**< The back buffer holds a frame waiting to be sent */
+static const stm32_dma_stream_t* ws2812_dma_stream;
+
+/* --- PRIVATE FUNCTIONS ---------------------------------------------------- */
+
+static void ws2812_start_transfer(uint8_t buffer) {
+    dmaStreamSetMemory0(ws2812_dma_stream, ws2812_frame_buffer[buffer]);
+    dmaStreamSetTransactionSize(ws2812_dma_stream, ws2812_frame_length[buffer]);
+    dmaStreamEnable(ws2812_dma_stream);
+}
+
+static void ws2812_dma_complete(void* param, uint32_t flags) {
+    (void)param;
+
+    if (!(flags & STM32_DMA_ISR_TCIF)) {
+        return;
+    }
+
+    osalSysLockFromISR();
+    dmaStreamDisable(ws2812_dma_stream);
+    if (ws2812_pending) {
+        // Send the queued frame, the buffer that was just sent becomes the back buffer
+        ws2812_start_transfer(ws2812_back);
+        ws2812_back ^= 1;
+        ws2812_pending = false;
+    } else {
+        ws2812_sending = false;
+    }
+    osalSysUnlockFromISR();
+}
+
+/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
+
+void ws2812_init(void) {
+    palSetLineMode(RGB_DI_PIN, WS2812_OUTPUT_MODE);
+
+    // Configure DMA, one transfer per frame instead of the circular mode of ws2812_pwm.c
+    ws2812_dma_stream = dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, ws2812_dma_complete, NULL);
+    dmaStreamSetPeripheral(ws2812_dma_stream, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1]));
+    dmaStreamSetMode(ws2812_dma_stream, STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_PSIZE_HWORD | STM32_DMA_CR_MSIZE_HWORD | STM32_DMA_CR_MINC | STM32_DMA_CR_TCIE | STM32_DMA_CR_PL(3));
+
+#if (STM32_DMA_SUPPORTS_DMAMUX == TRUE)
+    // If the MCU has a DMAMUX we need to assign the correct resource
+    dmaSetRequestSource(ws2812_dma_stream, WS2812_DMAMUX_ID);
+#endif
+
+    // Configure PWM
+    ws2812_pwm_start();
+}
+
+void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b) {
+    uint16_t* frame_buffer = ws2812_frame_buffer[ws2812_back];
+
+    // Write color to the back buffer
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        frame_buffer[WS2812_RED_BIT(led_number, bit)]   = WS2812_DUTYCYCLE(r, bit);
+        frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = WS2812_DUTYCYCLE(g, bit);
+        frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = WS2812_DUTYCYCLE(b, bit);
+    }
+}
+
+void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+    ws2812_write_led(led_number, r, g, b);
+#ifdef RGBW
+    uint16_t* frame_buffer = ws2812_frame_buffer[ws2812_back];
+
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        frame_buffer[WS2812_WHITE_BIT(led_number, bit)] = WS2812_DUTYCYCLE(w, bit);
+    }
+#endif
+}
+
+bool ws2812_ready(void) {
+    return !ws2812_pending;
+}
+
+// Setleds for standard RGB
+void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
+    static bool s_init = false;
+    if (!s_init) {
+        ws2812_init();
+        s_init = true;
+    }
+
+    if (leds > RGBLED_NUM) {
+        leds = RGBLED_NUM;
+    }
+
+    // A queued frame that has not been started yet is replaced by this one
+    osalSysLock();
+    ws2812_pending = false;
+    osalSysUnlock();
+
+    for (uint16_t i = 0; i < leds; i++) {
+#ifdef RGBW
+        ws2812_write_led_rgbw(i, ledarray[i].r, ledarray[i].g, ledarray[i].b, ledarray[i].w);
+#else
+        ws2812_write_led(i, ledarray[i].r, ledarray[i].g, ledarray[i].b);
+#endif
+    }
+
+    // Only the given LEDs are sent, the ones after them keep their colors
+    uint16_t* frame_buffer = ws2812_frame_buffer[ws2812_back];
+    uint16_t  color_bits   = leds * WS2812_COLOR_BITS;
+    for (uint16_t i = 0; i <= WS2812_RESET_BIT_N; i++) {
+        frame_buffer[color_bits + i] = 0;
+    }
+    ws2812_frame_length[ws2812_back] = color_bits + WS2812_RESET_BIT_N + 1;
+
+    osalSysLock();
+    if (ws2812_sending) {
+        // Sent by the DMA interrupt once the current frame is done
+        ws2812_pending = true;
+    } else {
+        ws2812_start_transfer(ws2812_back);
+        ws2812_back ^= 1;
+        ws2812_sending = true;
+    }
+    osalSysUnlock();
+}
@@ -1,4 +1,5 @@
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "action.h"
 #include "util.h"
@@ -42,6 +43,7 @@ static void default_layer_state_set(layer_state_t state) {
     default_layer_state = state;
     default_layer_debug();
     debug("\n");
+    layer_lookup_cache_invalidate();
 #ifdef STRICT_LAYER_RELEASE
     clear_keyboard_but_mods(); // To avoid stuck keys
 #else
@@ -122,6 +124,7 @@ void layer_state_set(layer_state_t state) {
     layer_state = state;
     layer_debug();
     dprintln();
+    layer_lookup_cache_invalidate();
 #    ifdef STRICT_LAYER_RELEASE
     clear_keyboard_but_mods(); // To avoid stuck keys
 #    else
@@ -284,11 +287,29 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+/** \brief resolved layers cache
  *
- * Gets the layer based on key info
+ * Topmost non-transparent layer of every key position for the current layer state.
+ * Entries are resolved lazily on lookup and dropped whenever the layer state or keymap changes.
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
+static uint8_t resolved_layers_cache[MATRIX_ROWS * MATRIX_COLS];
+static uint8_t resolved_layers_valid[(MATRIX_ROWS * MATRIX_COLS + 7) / 8];
+
+/** \brief Layer lookup cache invalidate
+ *
+ * Drops all cached layer lookups. Call this after changing the keymap at runtime.
+ */
+void layer_lookup_cache_invalidate(void) {
+    memset(resolved_layers_valid, 0, sizeof(resolved_layers_valid));
+}
+#endif
+
+/** \brief Layer switch resolve layer
+ *
+ * Walks the active layers from the top to find the first non-transparent action for the key
+ */
+static uint8_t layer_switch_resolve_layer(keypos_t key) {
 #ifndef NO_ACTION_LAYER
     action_t action;
     action.code = ACTION_TRANSPARENT;
@@ -310,6 +331,26 @@ uint8_t layer_switch_get_layer(keypos_t key) {
 #endif
 }
 
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        const uint16_t key_number  = key.col + (key.row * MATRIX_COLS);
+        const uint8_t  storage_bit = 1U << (key_number % 8);
+
+        if (!(resolved_layers_valid[key_number / 8] & storage_bit)) {
+            resolved_layers_cache[key_number] = layer_switch_resolve_layer(key);
+            resolved_layers_valid[key_number / 8] |= storage_bit;
+        }
+        return resolved_layers_cache[key_number];
+    }
+#endif
+    return layer_switch_resolve_layer(key);
+}
+
 /** \brief Layer switch get layer
  *
  * Gets action code based on key position
@@ -1,9 +1,11 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include "action.h"
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "timer.h"
 
 #ifdef DEBUG_ACTION
@@ -59,12 +61,41 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #    endif
 
 static keyrecord_t tapping_key                         = {};
+#    if (WAITING_BUFFER_SIZE & (WAITING_BUFFER_SIZE - 1)) != 0 || WAITING_BUFFER_SIZE > 128
+#        error "WAITING_BUFFER_SIZE must be a power of two, no larger than 128"
+#    endif
+
+// head and tail run freely, so all WAITING_BUFFER_SIZE entries can be used
+#    define WAITING_BUFFER_RECORD(i) (&waiting_buffer[(i) & (WAITING_BUFFER_SIZE - 1)])
+#    define WAITING_BUFFER_KEY_BIT(k) ((matrix_row_t)1 << (k).col)
+#    define IS_WAITING_BUFFER_INDEXED(k) ((k).row < MATRIX_ROWS && (k).col < MATRIX_COLS)
+
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
+// Matrix keys that may have a release ([0]) or press ([1]) in the waiting buffer, so looking up any other key needs no scan.
+// Bits are set on enqueue, and cleared when the buffer empties or a scan does not find the key.
+static matrix_row_t waiting_buffer_keys[2][MATRIX_ROWS] = {};
+
+#    ifdef TAPPING_FAST_RESOLUTION
+#        ifndef TAPPING_STREAK_TERM
+#            define TAPPING_STREAK_TERM 150
+#        endif
+
+// Times of the two most recently processed key presses, [0] being the latest
+static uint16_t tapping_streak_press_time[2] = {};
+static uint8_t  tapping_streak_presses       = 0;
+// Matrix keys settled as a tap during a typing streak that have not been released yet
+static matrix_row_t tapping_streak_taps[MATRIX_ROWS] = {};
+
+static void tapping_streak_record(keyrecord_t *record);
+static bool tapping_streak_resolves(keyevent_t event);
+static void tapping_streak_release(keyrecord_t *record);
+static void tapping_streak_clear(void);
+#    endif
 
 static bool process_tapping(keyrecord_t *record);
-static bool waiting_buffer_enq(keyrecord_t record);
+static bool waiting_buffer_enq(keyrecord_t *record);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -78,17 +109,23 @@ static void debug_waiting_buffer(void);
  */
 void action_tapping_process(keyrecord_t record) {
     if (process_tapping(&record)) {
+#    ifdef TAPPING_FAST_RESOLUTION
+        tapping_streak_record(&record);
+#    endif
         if (!IS_NOEVENT(record.event)) {
             debug("processed: ");
             debug_record(record);
             debug("\n");
         }
     } else {
-        if (!waiting_buffer_enq(record)) {
+        if (!waiting_buffer_enq(&record)) {
             // clear all in case of overflow.
             debug("OVERFLOW: CLEAR ALL STATES\n");
             clear_keyboard();
             waiting_buffer_clear();
+#    ifdef TAPPING_FAST_RESOLUTION
+            tapping_streak_clear();
+#    endif
             tapping_key = (keyrecord_t){};
         }
     }
@@ -97,15 +134,23 @@ void action_tapping_process(keyrecord_t record) {
     if (!IS_NOEVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         debug("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            debug("processed: waiting_buffer[");
-            debug_dec(waiting_buffer_tail);
-            debug("] = ");
-            debug_record(waiting_buffer[waiting_buffer_tail]);
-            debug("\n\n");
-        } else {
-            break;
+    if (waiting_buffer_tail != waiting_buffer_head) {
+        for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail++) {
+            if (process_tapping(WAITING_BUFFER_RECORD(waiting_buffer_tail))) {
+#    ifdef TAPPING_FAST_RESOLUTION
+                tapping_streak_record(WAITING_BUFFER_RECORD(waiting_buffer_tail));
+#    endif
+                debug("processed: waiting_buffer[");
+                debug_dec(waiting_buffer_tail & (WAITING_BUFFER_SIZE - 1));
+                debug("] = ");
+                debug_record(*WAITING_BUFFER_RECORD(waiting_buffer_tail));
+                debug("\n\n");
+            } else {
+                break;
+            }
+        }
+        if (waiting_buffer_tail == waiting_buffer_head) {
+            waiting_buffer_clear();
         }
     }
     if (!IS_NOEVENT(record.event)) {
@@ -121,6 +166,9 @@ void action_tapping_process(keyrecord_t record) {
 /* return true when key event is processed or consumed. */
 bool process_tapping(keyrecord_t *keyp) {
     keyevent_t event = keyp->event;
+#    ifdef TAPPING_FAST_RESOLUTION
+    tapping_streak_release(keyp);
+#    endif
 #    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)) || defined(TAPPING_TERM_PER_KEY) || defined(PERMISSIVE_HOLD_PER_KEY) || defined(TAPPING_FORCE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY)
     uint16_t tapping_keycode = get_record_keycode(&tapping_key, false);
 #    endif
@@ -257,6 +305,19 @@ bool process_tapping(keyrecord_t *keyp) {
                 } else {
                     // set interrupted flag when other key preesed during tapping
                     if (event.pressed) {
+#    ifdef TAPPING_FAST_RESOLUTION
+                        if (tapping_streak_resolves(event)) {
+                            debug("Tapping: First tap(0->1). Typing streak\n");
+                            tapping_key.tap.count = 1;
+                            if (IS_WAITING_BUFFER_INDEXED(tapping_key.event.key)) {
+                                tapping_streak_taps[tapping_key.event.key.row] |= WAITING_BUFFER_KEY_BIT(tapping_key.event.key);
+                            }
+                            debug_tapping_key();
+                            process_record(&tapping_key);
+                            // enqueue
+                            return false;
+                        }
+#    endif
                         tapping_key.tap.interrupted = true;
 #    if defined(HOLD_ON_OTHER_KEY_PRESS) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY)
 #        if defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY)
@@ -287,7 +348,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     tapping_key = *keyp;
                     debug_tapping_key();
                     return true;
-                } else if (is_tap_record(keyp) && event.pressed) {
+                } else if (event.pressed && is_tap_record(keyp)) {
                     if (tapping_key.tap.count > 1) {
                         debug("Tapping: Start new tap with releasing last tap(>1).\n");
                         // unregister key
@@ -333,7 +394,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     process_record(keyp);
                     tapping_key = (keyrecord_t){};
                     return true;
-                } else if (is_tap_record(keyp) && event.pressed) {
+                } else if (event.pressed && is_tap_record(keyp)) {
                     if (tapping_key.tap.count > 1) {
                         debug("Tapping: Start new tap with releasing last timeout tap(>1).\n");
                         // unregister key
@@ -445,22 +506,79 @@ bool process_tapping(keyrecord_t *keyp) {
     }
 }
 
+#    ifdef TAPPING_FAST_RESOLUTION
+/** \brief Typing streak record
+ *
+ * Remembers the time of a processed key press.
+ */
+static void tapping_streak_record(keyrecord_t *record) {
+    if (!IS_PRESSED(record->event)) {
+        return;
+    }
+    tapping_streak_press_time[1] = tapping_streak_press_time[0];
+    tapping_streak_press_time[0] = record->event.time;
+    if (tapping_streak_presses < 2) {
+        tapping_streak_presses++;
+    }
+}
+
+/** \brief Typing streak resolves
+ *
+ * Returns true if the undecided tapping key interrupted by this press is part of a typing streak, i.e. it was
+ * pressed within TAPPING_STREAK_TERM of the key before it and this press follows it just as closely. Presses
+ * pending in the waiting buffer have not been processed yet, so the tapping key is the latest processed press.
+ */
+static bool tapping_streak_resolves(keyevent_t event) {
+    return tapping_streak_presses == 2 && tapping_streak_press_time[0] == tapping_key.event.time && TIMER_DIFF_16(tapping_key.event.time, tapping_streak_press_time[1]) < TAPPING_STREAK_TERM && TIMER_DIFF_16(event.time, tapping_key.event.time) < TAPPING_STREAK_TERM;
+}
+
+/** \brief Typing streak release
+ *
+ * Gives the release of a key settled as a tap during a typing streak its tap count, so the tap is released
+ * even when another tapping key has started in the meantime. A new press of the key starts over, in case
+ * its release never made it here.
+ */
+static void tapping_streak_release(keyrecord_t *record) {
+    keypos_t key = record->event.key;
+    if (IS_NOEVENT(record->event) || !IS_WAITING_BUFFER_INDEXED(key) || !(tapping_streak_taps[key.row] & WAITING_BUFFER_KEY_BIT(key))) {
+        return;
+    }
+    tapping_streak_taps[key.row] &= ~WAITING_BUFFER_KEY_BIT(key);
+    if (IS_RELEASED(record->event)) {
+        record->tap.count = 1;
+    }
+}
+
+/** \brief Typing streak clear
+ *
+ * Forgets the streak, for when pending events are dropped along with the keyboard state.
+ */
+static void tapping_streak_clear(void) {
+    memset(tapping_streak_press_time, 0, sizeof(tapping_streak_press_time));
+    memset(tapping_streak_taps, 0, sizeof(tapping_streak_taps));
+    tapping_streak_presses = 0;
+}
+#    endif
+
 /** \brief Waiting buffer enq
  *
- * FIXME: Needs docs
+ * Appends a copy of the record and marks its key as present, returns false if the buffer is full.
  */
-bool waiting_buffer_enq(keyrecord_t record) {
-    if (IS_NOEVENT(record.event)) {
+bool waiting_buffer_enq(keyrecord_t *record) {
+    if (IS_NOEVENT(record->event)) {
         return true;
     }
 
-    if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
+    if ((uint8_t)(waiting_buffer_head - waiting_buffer_tail) == WAITING_BUFFER_SIZE) {
         debug("waiting_buffer_enq: Over flow.\n");
         return false;
     }
 
-    waiting_buffer[waiting_buffer_head] = record;
-    waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    *WAITING_BUFFER_RECORD(waiting_buffer_head) = *record;
+    waiting_buffer_head++;
+    if (IS_WAITING_BUFFER_INDEXED(record->event.key)) {
+        waiting_buffer_keys[record->event.pressed][record->event.key.row] |= WAITING_BUFFER_KEY_BIT(record->event.key);
+    }
 
     debug("waiting_buffer_enq: ");
     debug_waiting_buffer();
@@ -474,18 +592,42 @@ bool waiting_buffer_enq(keyrecord_t record) {
 void waiting_buffer_clear(void) {
     waiting_buffer_head = 0;
     waiting_buffer_tail = 0;
+    memset(waiting_buffer_keys, 0, sizeof(waiting_buffer_keys));
+}
+
+/** \brief Waiting buffer may contain
+ *
+ * Returns false if the waiting buffer certainly holds no event of the key in the given state.
+ */
+static bool waiting_buffer_may_contain(keypos_t key, bool pressed) {
+    return !IS_WAITING_BUFFER_INDEXED(key) || (waiting_buffer_keys[pressed][key.row] & WAITING_BUFFER_KEY_BIT(key));
+}
+
+/** \brief Waiting buffer forget
+ *
+ * Clears the mark of a key in the given state after a scan has found no such event.
+ */
+static void waiting_buffer_forget(keypos_t key, bool pressed) {
+    if (IS_WAITING_BUFFER_INDEXED(key)) {
+        waiting_buffer_keys[pressed][key.row] &= ~WAITING_BUFFER_KEY_BIT(key);
+    }
 }
 
 /** \brief Waiting buffer typed
  *
- * FIXME: Needs docs
+ * Returns true if the waiting buffer holds the opposite event of the same key.
  */
 bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
+    if (!waiting_buffer_may_contain(event.key, !event.pressed)) {
+        return false;
+    }
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
+        keyrecord_t *record = WAITING_BUFFER_RECORD(i);
+        if (KEYEQ(event.key, record->event.key) && event.pressed != record->event.pressed) {
             return true;
         }
     }
+    waiting_buffer_forget(event.key, !event.pressed);
     return false;
 }
 
@@ -494,8 +636,8 @@ bool waiting_buffer_typed(keyevent_t event) {
  * FIXME: Needs docs
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
+        if (WAITING_BUFFER_RECORD(i)->event.pressed) return true;
     }
     return false;
 }
@@ -510,14 +652,18 @@ void waiting_buffer_scan_tap(void) {
     // invalid state: tapping_key released && tap.count == 0
     if (!tapping_key.event.pressed) return;
 
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (IS_TAPPING_KEY(waiting_buffer[i].event.key) && !waiting_buffer[i].event.pressed && WITHIN_TAPPING_TERM(waiting_buffer[i].event)) {
-            tapping_key.tap.count       = 1;
-            waiting_buffer[i].tap.count = 1;
+    // the tapping key has not been released yet
+    if (!waiting_buffer_may_contain(tapping_key.event.key, false)) return;
+
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
+        keyrecord_t *record = WAITING_BUFFER_RECORD(i);
+        if (IS_TAPPING_KEY(record->event.key) && !record->event.pressed && WITHIN_TAPPING_TERM(record->event)) {
+            tapping_key.tap.count = 1;
+            record->tap.count     = 1;
             process_record(&tapping_key);
 
             debug("waiting_buffer_scan_tap: found at [");
-            debug_dec(i);
+            debug_dec(i & (WAITING_BUFFER_SIZE - 1));
             debug("]\n");
             debug_waiting_buffer();
             return;
@@ -541,11 +687,11 @@ static void debug_tapping_key(void) {
  */
 static void debug_waiting_buffer(void) {
     debug("{ ");
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
         debug("[");
-        debug_dec(i);
+        debug_dec(i & (WAITING_BUFFER_SIZE - 1));
         debug("]=");
-        debug_record(waiting_buffer[i]);
+        debug_record(*WAITING_BUFFER_RECORD(i));
         debug(" ");
     }
     debug("}\n");
@@ -108,6 +108,89 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+#ifndef __AVR__
+// Which of v, p, q and t (in this order) becomes red, green and blue in each hue region,
+// two bits per channel. Picking by index avoids the unpredictable branches of the switch above.
+static const uint8_t hsv_region_channels[7] = {
+    0 | 3 << 2 | 1 << 4, // v, t, p
+    2 | 0 << 2 | 1 << 4, // q, v, p
+    1 | 0 << 2 | 3 << 4, // p, v, t
+    1 | 2 << 2 | 0 << 4, // p, q, v
+    3 | 1 << 2 | 0 << 4, // t, p, v
+    0 | 1 << 2 | 2 << 4, // v, p, q
+    0 | 3 << 2 | 1 << 4, // v, t, p
+};
+
+static inline __attribute__((always_inline)) RGB hsv_to_rgb_select(HSV hsv, bool use_cie) {
+    uint16_t h = hsv.h;
+    uint16_t s = hsv.s;
+    uint16_t v;
+#    ifdef USE_CIE1931_CURVE
+    if (use_cie) {
+        v = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
+    } else {
+        v = hsv.v;
+    }
+#    else
+    v = hsv.v;
+#    endif
+
+    // h * 6 / 255 without a division, exact for h * 6 < 65535
+    uint16_t h6        = h * 6;
+    uint8_t  region    = (h6 + 1 + (h6 >> 8)) >> 8;
+    uint8_t  remainder = (h * 2 - region * 85) * 3;
+
+    // v, p, q and t packed into one word, so that the channels are picked with shifts
+    uint32_t values = v;
+    if (s) {
+        values |= (uint32_t)((v * (255 - s)) >> 8) << 8;
+        values |= (uint32_t)((v * (255 - ((s * remainder) >> 8))) >> 8) << 16;
+        values |= (uint32_t)((v * (255 - ((s * (255 - remainder)) >> 8))) >> 8) << 24;
+    } else {
+        // Without saturation all channels are v
+        values *= 0x01010101;
+    }
+
+    uint8_t channels = hsv_region_channels[region];
+    RGB     rgb;
+    rgb.r = values >> ((channels & 3) * 8);
+    rgb.g = values >> (((channels >> 2) & 3) * 8);
+    rgb.b = values >> (((channels >> 4) & 3) * 8);
+    return rgb;
+}
+#endif
+
+static void hsv_to_rgb_batch_impl(const HSV *hsv, RGB *rgb, uint16_t count, bool use_cie) {
+#ifdef __AVR__
+    // Variable 32-bit shifts are loops on AVR, the switch is faster there
+    for (uint16_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb_impl(hsv[i], use_cie);
+    }
+#else
+    if (use_cie) {
+        for (uint16_t i = 0; i < count; i++) {
+            rgb[i] = hsv_to_rgb_select(hsv[i], true);
+        }
+    } else {
+        for (uint16_t i = 0; i < count; i++) {
+            rgb[i] = hsv_to_rgb_select(hsv[i], false);
+        }
+    }
+#endif
+}
+
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint16_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_batch_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+#endif
+}
+
+void hsv_to_rgb_nocie_batch(const HSV *hsv, RGB *rgb, uint16_t count) {
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+}
+
 #ifdef RGBW
 #    ifndef MIN
 #        define MIN(a, b) ((a) < (b) ? (a) : (b))
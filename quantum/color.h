@@ -145,6 +145,9 @@ typedef struct PACKED {
 
 RGB hsv_to_rgb(HSV hsv);
 RGB hsv_to_rgb_nocie(HSV hsv);
+// Convert count colors at once, with the same results as hsv_to_rgb() and hsv_to_rgb_nocie()
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint16_t count);
+void hsv_to_rgb_nocie_batch(const HSV *hsv, RGB *rgb, uint16_t count);
 #ifdef RGBW
 void convert_rgb_to_rgbw(LED_TYPE *led);
 #endif
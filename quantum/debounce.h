@@ -1,5 +1,8 @@
 #pragma once
 
+#include <stdbool.h>
+#include "timer.h"
+
 // raw is the current key state
 // on entry cooked is the previous debounced state
 // on exit cooked is the current debounced state
@@ -9,3 +12,20 @@ void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 void debounce_init(uint8_t num_rows);
 
 void debounce_free(void);
+
+#ifdef DEBOUNCE_TRACKS_EXPIRY
+// returns false if nothing is waiting for a debounce period to end,
+// otherwise sets expiry to the time debounce() has to be called again even if raw has not changed
+bool debounce_next_expiry(fast_timer_t *expiry);
+
+// whether the matrix scan has to call debounce() this time
+static inline bool debounce_required(bool changed) {
+    fast_timer_t expiry;
+    return changed || (debounce_next_expiry(&expiry) && timer_expired_fast(timer_read_fast(), expiry));
+}
+#else
+// algorithms that do not track their next expiry are run on every scan
+static inline bool debounce_required(bool changed) {
+    return true;
+}
+#endif
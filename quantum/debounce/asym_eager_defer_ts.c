@@ -0,0 +1,172 @@
+/*
+Copyright 2022 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Asymmetric per-key algorithm with the same behaviour as asym_eager_defer_pk, driven by timestamps.
+Key-down is reported immediately and then locked for DEBOUNCE milliseconds, key-up is reported once
+it has been stable for DEBOUNCE milliseconds. Every key remembers when its debounce period started
+instead of counting down by the time between scans, so a slow scan loop cannot make periods drift,
+and the earliest deadline is tracked so debounce() can be skipped until it is reached.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include "debounce.h"
+#include <stdlib.h>
+
+#ifdef PROTOCOL_CHIBIOS
+#    if CH_CFG_USE_MEMCORE == FALSE
+#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
+#    endif
+#endif
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#define ROW_SHIFTER ((matrix_row_t)1)
+
+#if DEBOUNCE > 0
+typedef struct {
+    matrix_row_t pending; // keys within their debounce period
+    matrix_row_t pressed; // direction of the change that started the period
+} debounce_row_t;
+
+static debounce_row_t *debounce_rows;
+static uint16_t *      debounce_start; // low 16 bits of the time each key's period started
+static fast_timer_t    next_expiry;
+static bool            periods_pending;
+static bool            matrix_need_update;
+
+static void expire_debounce_periods(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, fast_timer_t now);
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, fast_timer_t now);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_rows      = calloc(num_rows, sizeof(debounce_row_t));
+    debounce_start     = calloc(num_rows * MATRIX_COLS, sizeof(uint16_t));
+    periods_pending    = false;
+    matrix_need_update = false;
+}
+
+void debounce_free(void) {
+    free(debounce_rows);
+    free(debounce_start);
+    debounce_rows  = NULL;
+    debounce_start = NULL;
+}
+
+bool debounce_next_expiry(fast_timer_t *expiry) {
+    *expiry = next_expiry;
+    return periods_pending;
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    fast_timer_t now = timer_read_fast();
+
+    if (periods_pending && timer_expired_fast(now, next_expiry)) {
+        expire_debounce_periods(raw, cooked, num_rows, now);
+    }
+
+    if (changed || matrix_need_update) {
+        matrix_need_update = false;
+        transfer_matrix_values(raw, cooked, num_rows, now);
+    }
+}
+
+static void expire_debounce_periods(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, fast_timer_t now) {
+    uint16_t shortest_remaining = UINT16_MAX;
+
+    periods_pending = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t pending = debounce_rows[row].pending;
+        uint16_t *   start   = &debounce_start[row * MATRIX_COLS];
+
+        for (uint8_t col = 0; pending; col++, pending >>= 1) {
+            if (!(pending & 1)) {
+                continue;
+            }
+
+            matrix_row_t col_mask = (ROW_SHIFTER << col);
+            uint16_t     elapsed  = (uint16_t)now - start[col];
+            if (elapsed >= DEBOUNCE) {
+                debounce_rows[row].pending &= ~col_mask;
+                if (debounce_rows[row].pressed & col_mask) {
+                    // key-down: eager, pick up anything that changed while it was locked
+                    matrix_need_update = true;
+                } else {
+                    // key-up: defer
+                    cooked[row] = (cooked[row] & ~col_mask) | (raw[row] & col_mask);
+                }
+            } else {
+                periods_pending = true;
+                if (DEBOUNCE - elapsed < shortest_remaining) {
+                    shortest_remaining = DEBOUNCE - elapsed;
+                }
+            }
+        }
+    }
+
+    if (periods_pending) {
+        next_expiry = now + shortest_remaining;
+    }
+}
+
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, fast_timer_t now) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        debounce_row_t *state = &debounce_rows[row];
+        matrix_row_t    delta = raw[row] ^ cooked[row];
+
+        // key-up: defer, a key that is released and pressed again within its period stops waiting
+        state->pending &= delta | state->pressed;
+
+        matrix_row_t start = delta & ~state->pending;
+        if (!start) {
+            continue;
+        }
+
+        state->pending |= start;
+        state->pressed = (state->pressed & ~start) | (raw[row] & start);
+        // key-down: eager
+        cooked[row] |= raw[row] & start;
+
+        uint16_t *start_time = &debounce_start[row * MATRIX_COLS];
+        for (uint8_t col = 0; start; col++, start >>= 1) {
+            if (start & 1) {
+                start_time[col] = (uint16_t)now;
+            }
+        }
+
+        // Periods that started earlier always end earlier
+        if (!periods_pending) {
+            periods_pending = true;
+            next_expiry     = now + DEBOUNCE;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+
+bool debounce_next_expiry(fast_timer_t *expiry) {
+    return false;
+}
+#endif
@@ -0,0 +1,176 @@
+/*
+Copyright 2022 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Symmetric per-key algorithm with the same behaviour as sym_defer_pk, using vertical counters.
+Bit n of every key's counter is kept in bit-plane n of its row, so a whole row of counters is
+started, decremented and checked for expiry with a few word-wide operations instead of a loop
+over every column. When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include <stdlib.h>
+
+#ifdef PROTOCOL_CHIBIOS
+#    if CH_CFG_USE_MEMCORE == FALSE
+#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
+#    endif
+#endif
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+// Number of bit-planes needed to hold DEBOUNCE
+#if DEBOUNCE < 2
+#    define DEBOUNCE_PLANES 1
+#elif DEBOUNCE < 4
+#    define DEBOUNCE_PLANES 2
+#elif DEBOUNCE < 8
+#    define DEBOUNCE_PLANES 3
+#elif DEBOUNCE < 16
+#    define DEBOUNCE_PLANES 4
+#elif DEBOUNCE < 32
+#    define DEBOUNCE_PLANES 5
+#elif DEBOUNCE < 64
+#    define DEBOUNCE_PLANES 6
+#elif DEBOUNCE < 128
+#    define DEBOUNCE_PLANES 7
+#else
+#    define DEBOUNCE_PLANES 8
+#endif
+
+#if DEBOUNCE > 0
+// A key is idle (its counter has elapsed) when its bit is clear in every plane of its row
+typedef struct {
+    matrix_row_t plane[DEBOUNCE_PLANES];
+} debounce_counter_row_t;
+
+static debounce_counter_row_t *debounce_counters;
+static fast_timer_t            last_time;
+static bool                    counters_need_update;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_counters = (debounce_counter_row_t *)calloc(num_rows, sizeof(debounce_counter_row_t));
+}
+
+void debounce_free(void) {
+    free(debounce_counters);
+    debounce_counters = NULL;
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t *plane  = debounce_counters[row].plane;
+        matrix_row_t  active = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            active |= plane[bit];
+        }
+        if (!active) {
+            continue;
+        }
+
+        // Subtract elapsed_time from every active counter of the row, rippling the borrow through the planes
+        matrix_row_t expired;
+        if (elapsed_time >> DEBOUNCE_PLANES) {
+            expired = active;
+        } else {
+            matrix_row_t borrow    = 0;
+            matrix_row_t remaining = 0;
+            for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+                matrix_row_t subtrahend = (elapsed_time & (1 << bit)) ? active : 0;
+                matrix_row_t minuend    = plane[bit];
+                plane[bit]              = minuend ^ subtrahend ^ borrow;
+                borrow                  = (~minuend & (subtrahend | borrow)) | (subtrahend & borrow);
+                remaining |= plane[bit];
+            }
+            // A counter has elapsed once it is less than or equal to elapsed_time
+            expired = active & (borrow | ~remaining);
+        }
+
+        if (expired) {
+            for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+                plane[bit] &= ~expired;
+            }
+            cooked[row] = (cooked[row] & ~expired) | (raw[row] & expired);
+        }
+        if (active & ~expired) {
+            counters_need_update = true;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t *plane  = debounce_counters[row].plane;
+        matrix_row_t  delta  = raw[row] ^ cooked[row];
+        matrix_row_t  active = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            active |= plane[bit];
+        }
+
+        // Idle keys that differ start counting from DEBOUNCE, keys that match again stop counting
+        matrix_row_t start = delta & ~active;
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            plane[bit] = (plane[bit] & delta) | ((DEBOUNCE & (1 << bit)) ? start : 0);
+        }
+        if (start) {
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
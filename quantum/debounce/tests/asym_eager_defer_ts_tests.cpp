@@ -0,0 +1,100 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "quantum.h"
+#include "timer.h"
+#include "debounce.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+class DebounceNextExpiry : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(7777);
+        debounce_init(MATRIX_ROWS);
+    }
+
+    void TearDown() override {
+        debounce_free();
+    }
+
+    void scan(bool changed) {
+        debounce(raw_, cooked_, MATRIX_ROWS, changed);
+    }
+
+    matrix_row_t raw_[MATRIX_ROWS]    = {0};
+    matrix_row_t cooked_[MATRIX_ROWS] = {0};
+};
+
+TEST_F(DebounceNextExpiry, NothingPendingWhenIdle) {
+    fast_timer_t expiry;
+
+    EXPECT_FALSE(debounce_next_expiry(&expiry));
+    EXPECT_FALSE(debounce_required(false));
+    EXPECT_TRUE(debounce_required(true));
+}
+
+TEST_F(DebounceNextExpiry, ExpiryFollowsEarliestKey) {
+    fast_timer_t expiry;
+
+    raw_[0] = 1;
+    scan(true);
+    EXPECT_EQ(cooked_[0], 1);
+    ASSERT_TRUE(debounce_next_expiry(&expiry));
+    EXPECT_EQ(expiry, (fast_timer_t)(7777 + DEBOUNCE));
+
+    advance_time(2);
+    raw_[1] = 1;
+    scan(true);
+    ASSERT_TRUE(debounce_next_expiry(&expiry));
+    EXPECT_EQ(expiry, (fast_timer_t)(7777 + DEBOUNCE));
+
+    advance_time(DEBOUNCE - 3);
+    EXPECT_FALSE(debounce_required(false));
+    advance_time(1);
+    EXPECT_TRUE(debounce_required(false));
+    scan(false);
+    ASSERT_TRUE(debounce_next_expiry(&expiry));
+    EXPECT_EQ(expiry, (fast_timer_t)(7777 + 2 + DEBOUNCE));
+
+    advance_time(2);
+    scan(false);
+    EXPECT_FALSE(debounce_next_expiry(&expiry));
+}
+
+TEST_F(DebounceNextExpiry, LateScanReleasesOnFirstCall) {
+    fast_timer_t expiry;
+
+    raw_[2] = 1 << 3;
+    scan(true);
+    advance_time(DEBOUNCE);
+    scan(false);
+    raw_[2] = 0;
+    scan(true);
+    EXPECT_EQ(cooked_[2], 1 << 3);
+
+    // A single scan long after the release period ended is enough
+    advance_time(50);
+    EXPECT_TRUE(debounce_required(false));
+    scan(false);
+    EXPECT_EQ(cooked_[2], 0);
+    EXPECT_FALSE(debounce_next_expiry(&expiry));
+}
@@ -0,0 +1,141 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+extern "C" {
+#include "quantum.h"
+#include "timer.h"
+#include "debounce.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+/* Straightforward per-key model of the symmetric deferred algorithm, used as the reference */
+class ReferenceDebounce {
+   public:
+    void debounce(const matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
+        bool updated_last = false;
+
+        if (need_update_) {
+            fast_timer_t now     = timer_read_fast();
+            fast_timer_t elapsed = TIMER_DIFF_FAST(now, last_time_);
+            last_time_           = now;
+            updated_last         = true;
+            if (elapsed > UINT8_MAX) elapsed = UINT8_MAX;
+
+            if (elapsed > 0) {
+                need_update_ = false;
+            }
+            for (uint8_t row = 0; elapsed > 0 && row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    uint8_t &counter = counters_[row][col];
+                    if (counter == 0) {
+                        continue;
+                    } else if (counter <= elapsed) {
+                        counter     = 0;
+                        cooked[row] = (cooked[row] & ~bit(col)) | (raw[row] & bit(col));
+                    } else {
+                        counter -= elapsed;
+                        need_update_ = true;
+                    }
+                }
+            }
+        }
+
+        if (changed) {
+            if (!updated_last) {
+                last_time_ = timer_read_fast();
+            }
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    uint8_t &counter = counters_[row][col];
+                    if ((raw[row] ^ cooked[row]) & bit(col)) {
+                        if (counter == 0) {
+                            counter      = DEBOUNCE;
+                            need_update_ = true;
+                        }
+                    } else {
+                        counter = 0;
+                    }
+                }
+            }
+        }
+    }
+
+   private:
+    static matrix_row_t bit(uint8_t col) {
+        return (matrix_row_t)1 << col;
+    }
+
+    uint8_t      counters_[MATRIX_ROWS][MATRIX_COLS] = {};
+    fast_timer_t last_time_                          = 0;
+    bool         need_update_                        = false;
+};
+
+TEST(DebounceBenchmark, RandomBounce) {
+    const uint32_t scans = 200000;
+
+    std::mt19937                     rng(42);
+    std::uniform_int_distribution<>  percent(0, 99);
+    std::uniform_int_distribution<>  row_dist(0, MATRIX_ROWS - 1);
+    std::uniform_int_distribution<>  col_dist(0, MATRIX_COLS - 1);
+    matrix_row_t                     raw[MATRIX_ROWS]        = {0};
+    matrix_row_t                     cooked[MATRIX_ROWS]     = {0};
+    matrix_row_t                     ref_cooked[MATRIX_ROWS] = {0};
+    ReferenceDebounce                reference;
+    std::chrono::nanoseconds         elapsed(0);
+    uint32_t                         output_changes = 0;
+
+    set_time(1000);
+    debounce_init(MATRIX_ROWS);
+
+    for (uint32_t scan = 0; scan < scans; scan++) {
+        // Mostly quiet scans, with bursts of bouncing across several keys at once
+        bool changed = false;
+        int  roll    = percent(rng);
+        if (roll < 20) {
+            for (int flips = roll % 6; flips >= 0; flips--) {
+                raw[row_dist(rng)] ^= (matrix_row_t)1 << col_dist(rng);
+            }
+            changed = true;
+        }
+
+        matrix_row_t previous[MATRIX_ROWS];
+        memcpy(previous, cooked, sizeof(cooked));
+
+        auto start = std::chrono::steady_clock::now();
+        debounce(raw, cooked, MATRIX_ROWS, changed);
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        reference.debounce(raw, ref_cooked, changed);
+        ASSERT_EQ(memcmp(cooked, ref_cooked, sizeof(cooked)), 0) << "cooked matrix differs from the reference at scan " << scan;
+        output_changes += memcmp(previous, cooked, sizeof(cooked)) != 0;
+
+        // Scan rate varies between several scans per millisecond and a few milliseconds per scan
+        advance_time(roll < 50 ? 1 : (roll < 80 ? 0 : roll % 4));
+    }
+    debounce_free();
+
+    EXPECT_GT(output_changes, 0);
+    std::cout << "[ BENCH    ] " << MATRIX_ROWS << "x" << MATRIX_COLS << " matrix: " << (double)elapsed.count() / scans << " ns per debounce() call" << std::endl;
+}
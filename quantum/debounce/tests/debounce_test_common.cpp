@@ -41,12 +41,18 @@ void DebounceTest::runEvents() {
         if (time_jumps_) {
             /* Don't advance time smoothly, jump to the next event (some tests require this) */
             auto_advance_time_ = false;
+            irregular_scans_   = false;
             runEventsInternal();
         } else {
-            /* Run the test with both smooth and irregular time; it must produce the same result */
+            /* Run the test with smooth time, with scans at irregular intervals that skip debounce() when it has nothing to do,
+             * and with time jumping between events; it must produce the same result */
             auto_advance_time_ = true;
+            irregular_scans_   = false;
+            runEventsInternal();
+            irregular_scans_ = true;
             runEventsInternal();
             auto_advance_time_ = false;
+            irregular_scans_   = false;
             runEventsInternal();
         }
     }
@@ -59,6 +65,7 @@ void DebounceTest::runEventsInternal() {
     /* Initialise keyboard with start time (offset to avoid testing at 0) and all keys UP */
     debounce_init(MATRIX_ROWS);
     set_time(time_offset_);
+    scan_interval_index_ = 0;
     std::fill(std::begin(input_matrix_), std::end(input_matrix_), 0);
     std::fill(std::begin(output_matrix_), std::end(output_matrix_), 0);
 
@@ -74,9 +81,9 @@ void DebounceTest::runEventsInternal() {
             ASSERT_LT((time_offset_ + event.time_) - timer_read_fast(), 60000) << "Test tries to advance more than 1 minute of time";
 
             while (timer_read_fast() != time_offset_ + event.time_) {
-                runDebounce(false);
+                scanDebounce();
                 checkCookedMatrix(false, "debounce() modified cooked matrix");
-                advance_time(1);
+                advanceScanTime(time_offset_ + event.time_);
             }
         }
 
@@ -106,16 +113,17 @@ void DebounceTest::runEventsInternal() {
 
         /* Perform some extra iterations of the matrix scan with no changes */
         for (int i = 0; i < extra_iterations_; i++) {
-            runDebounce(false);
+            scanDebounce();
             checkCookedMatrix(false, "debounce() modified cooked matrix");
         }
     }
 
     /* Check that no further changes happen for 1 minute */
-    for (int i = 0; i < 60000; i++) {
-        runDebounce(false);
+    fast_timer_t end = timer_read_fast() + 60000;
+    while (timer_read_fast() != end) {
+        scanDebounce();
         checkCookedMatrix(false, "debounce() modified cooked matrix");
-        advance_time(1);
+        advanceScanTime(end);
     }
 
     debounce_free();
@@ -132,6 +140,24 @@ void DebounceTest::runDebounce(bool changed) {
     }
 }
 
+/* Scan with no changes, skipping debounce() when irregular scans are enabled and it has nothing to do, as the matrix scan does */
+void DebounceTest::scanDebounce(void) {
+    if (!irregular_scans_ || debounce_required(false)) {
+        runDebounce(false);
+    }
+}
+
+/* Advance to the next scan, by 1ms or by a varying number of milliseconds that never passes the target time */
+void DebounceTest::advanceScanTime(fast_timer_t target) {
+    static const fast_timer_t intervals[] = {1, 3, 2, 5, 1, 4, 7};
+    fast_timer_t              interval    = 1;
+
+    if (irregular_scans_) {
+        interval = std::min(intervals[scan_interval_index_++ % (sizeof(intervals) / sizeof(intervals[0]))], (fast_timer_t)(target - timer_read_fast()));
+    }
+    advance_time(interval);
+}
+
 void DebounceTest::checkCookedMatrix(bool changed, const std::string &error_message) {
     if (!std::equal(std::begin(output_matrix_), std::end(output_matrix_), std::begin(cooked_matrix_))) {
         FAIL() << "Unexpected event: " << error_message << " at " << strTime() << "\ninput_matrix: changed=" << changed << "\n" << strMatrix(input_matrix_) << "\nexpected_matrix:\n" << strMatrix(output_matrix_) << "\nactual_matrix:\n" << strMatrix(cooked_matrix_);
@@ -141,7 +167,7 @@ void DebounceTest::checkCookedMatrix(bool changed, const std::string &error_mess
 std::string DebounceTest::strTime() {
     std::stringstream text;
 
-    text << "time " << (timer_read_fast() - time_offset_) << " (extra_iterations=" << extra_iterations_ << ", auto_advance_time=" << auto_advance_time_ << ")";
+    text << "time " << (timer_read_fast() - time_offset_) << " (extra_iterations=" << extra_iterations_ << ", auto_advance_time=" << auto_advance_time_ << ", irregular_scans=" << irregular_scans_ << ")";
 
     return text.str();
 }
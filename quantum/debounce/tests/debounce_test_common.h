@@ -63,6 +63,8 @@ class DebounceTest : public ::testing::Test {
 
     void runEventsInternal();
     void runDebounce(bool changed);
+    void scanDebounce(void);
+    void advanceScanTime(fast_timer_t target);
     void checkCookedMatrix(bool changed, const std::string &error_message);
     void matrixUpdate(matrix_row_t matrix[], const std::string &name, const MatrixTestEvent &event);
 
@@ -78,4 +80,6 @@ class DebounceTest : public ::testing::Test {
 
     int  extra_iterations_;
     bool auto_advance_time_;
+    bool irregular_scans_;
+    int  scan_interval_index_;
 };
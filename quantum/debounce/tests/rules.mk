@@ -47,3 +47,26 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+debounce_sym_defer_vc_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_defer_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp
+
+debounce_asym_eager_defer_ts_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_TRACKS_EXPIRY
+debounce_asym_eager_defer_ts_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/asym_eager_defer_ts.c \
+	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_ts_tests.cpp
+
+DEBOUNCE_BENCHMARK_DEFS := -DMATRIX_ROWS=8 -DMATRIX_COLS=32 -DDEBOUNCE=5
+
+debounce_sym_defer_pk_benchmark_DEFS := $(DEBOUNCE_BENCHMARK_DEFS)
+debounce_sym_defer_pk_benchmark_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_benchmark_tests.cpp
+
+debounce_sym_defer_vc_benchmark_DEFS := $(DEBOUNCE_BENCHMARK_DEFS)
+debounce_sym_defer_vc_benchmark_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_benchmark_tests.cpp
@@ -88,19 +88,121 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
     return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
 }
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// Keymap layers are mirrored in RAM, in the same big-endian layout as in EEPROM.
+// Writes update the mirror immediately and are written back to EEPROM in batches
+// once no further writes have happened for DYNAMIC_KEYMAP_FLUSH_DELAY milliseconds.
+#    ifndef DYNAMIC_KEYMAP_FLUSH_DELAY
+#        define DYNAMIC_KEYMAP_FLUSH_DELAY 500
+#    endif
+
+// Maximum number of bytes written to EEPROM per call of dynamic_keymap_task()
+#    ifndef DYNAMIC_KEYMAP_FLUSH_SIZE
+#        define DYNAMIC_KEYMAP_FLUSH_SIZE 32
+#    endif
+
+#    define DYNAMIC_KEYMAP_KEY_COUNT (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS)
+
+static uint8_t  dynamic_keymap_mirror[DYNAMIC_KEYMAP_KEY_COUNT * 2];
+static uint8_t  dynamic_keymap_dirty[(DYNAMIC_KEYMAP_KEY_COUNT + 7) / 8];
+static bool     dynamic_keymap_mirror_loaded = false;
+static bool     dynamic_keymap_has_dirty     = false;
+static uint16_t dynamic_keymap_last_write    = 0;
+
+static void dynamic_keymap_mirror_load(void) {
+    if (!dynamic_keymap_mirror_loaded) {
+        eeprom_read_block(dynamic_keymap_mirror, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(dynamic_keymap_mirror));
+        dynamic_keymap_mirror_loaded = true;
+    }
+}
+
+static void dynamic_keymap_mirror_write(uint16_t offset, uint8_t data) {
+    if (dynamic_keymap_mirror[offset] != data) {
+        dynamic_keymap_mirror[offset] = data;
+        dynamic_keymap_dirty[offset / 16] |= 1 << ((offset / 2) % 8);
+        dynamic_keymap_has_dirty  = true;
+        dynamic_keymap_last_write = timer_read();
+    }
+}
+
+// Reloads the mirror after the EEPROM has been erased underneath it. Every keycode is marked
+// dirty, so whatever is written next reaches EEPROM even if the stale mirror already held it.
+void dynamic_keymap_mirror_invalidate(void) {
+    dynamic_keymap_mirror_loaded = false;
+    dynamic_keymap_mirror_load();
+    for (uint16_t i = 0; i < DYNAMIC_KEYMAP_KEY_COUNT; i++) {
+        dynamic_keymap_dirty[i / 8] |= 1 << (i % 8);
+    }
+    dynamic_keymap_has_dirty  = true;
+    dynamic_keymap_last_write = timer_read();
+}
+
+// Writes back the first run of dirty keycodes, at most DYNAMIC_KEYMAP_FLUSH_SIZE bytes of it.
+// Returns false once nothing is left to write.
+static bool dynamic_keymap_flush_chunk(void) {
+    uint16_t start = DYNAMIC_KEYMAP_KEY_COUNT;
+    for (uint16_t i = 0; i < sizeof(dynamic_keymap_dirty); i++) {
+        if (dynamic_keymap_dirty[i]) {
+            start = i * 8;
+            while (!(dynamic_keymap_dirty[start / 8] & (1 << (start % 8)))) {
+                start++;
+            }
+            break;
+        }
+    }
+    if (start >= DYNAMIC_KEYMAP_KEY_COUNT) {
+        dynamic_keymap_has_dirty = false;
+        return false;
+    }
+
+    uint16_t end = start;
+    while (end < DYNAMIC_KEYMAP_KEY_COUNT && (end - start) * 2 < DYNAMIC_KEYMAP_FLUSH_SIZE && (dynamic_keymap_dirty[end / 8] & (1 << (end % 8)))) {
+        dynamic_keymap_dirty[end / 8] &= ~(1 << (end % 8));
+        end++;
+    }
+    eeprom_update_block(&dynamic_keymap_mirror[start * 2], (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + start * 2), (end - start) * 2);
+    return true;
+}
+
+void dynamic_keymap_flush(void) {
+    while (dynamic_keymap_has_dirty && dynamic_keymap_flush_chunk()) {
+    }
+}
+
+void dynamic_keymap_task(void) {
+    if (dynamic_keymap_has_dirty && timer_elapsed(dynamic_keymap_last_write) >= DYNAMIC_KEYMAP_FLUSH_DELAY) {
+        dynamic_keymap_flush_chunk();
+    }
+}
+#endif
+
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    uint16_t offset = ((layer * MATRIX_ROWS * MATRIX_COLS) + (row * MATRIX_COLS) + column) * 2;
+    dynamic_keymap_mirror_load();
+    return (dynamic_keymap_mirror[offset] << 8) | dynamic_keymap_mirror[offset + 1];
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    uint16_t offset = ((layer * MATRIX_ROWS * MATRIX_COLS) + (row * MATRIX_COLS) + column) * 2;
+    dynamic_keymap_mirror_load();
+    dynamic_keymap_mirror_write(offset, (uint8_t)(keycode >> 8));
+    dynamic_keymap_mirror_write(offset + 1, (uint8_t)(keycode & 0xFF));
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#endif
+    layer_lookup_cache_invalidate();
 }
 
 void dynamic_keymap_reset(void) {
@@ -118,6 +220,16 @@ void dynamic_keymap_reset(void) {
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_mirror_load();
+    for (uint16_t i = 0; i < size; i++) {
+        if (offset + i < dynamic_keymap_eeprom_size) {
+            data[i] = dynamic_keymap_mirror[offset + i];
+        } else {
+            data[i] = 0x00;
+        }
+    }
+#else
     void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
@@ -129,10 +241,19 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+#endif
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_mirror_load();
+    for (uint16_t i = 0; i < size; i++) {
+        if (offset + i < dynamic_keymap_eeprom_size) {
+            dynamic_keymap_mirror_write(offset + i, data[i]);
+        }
+    }
+#else
     void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
@@ -142,6 +263,8 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+#endif
+    layer_lookup_cache_invalidate();
 }
 
 // This overrides the one in quantum/keymap_common.c
@@ -227,28 +350,13 @@ void dynamic_keymap_macro_send(uint8_t id) {
         ++p;
     }
 
-    // Send the macro string one or three chars at a time
-    // by making temporary 1 or 3 char strings
-    char data[4] = {0, 0, 0, 0};
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Typed from keyboard_task(), read straight out of EEPROM. The buffer can be
+    // rewritten in the meantime, so never read past its end
+    send_string_async_eeprom_macro(p, end, NULL);
+#else
     // We already checked there was a null at the end of
-    // the buffer, so this cannot go past the end
-    while (1) {
-        data[0] = eeprom_read_byte(p++);
-        data[1] = 0;
-        // Stop at the null terminator of this macro string
-        if (data[0] == 0) {
-            break;
-        }
-        // If the char is magic (tap, down, up),
-        // add the next char (key to use) and send a 3 char string.
-        if (data[0] == SS_TAP_CODE || data[0] == SS_DOWN_CODE || data[0] == SS_UP_CODE) {
-            data[1] = data[0];
-            data[0] = SS_QMK_PREFIX;
-            data[2] = eeprom_read_byte(p++);
-            if (data[2] == 0) {
-                break;
-            }
-        }
-        send_string(data);
-    }
+    // the buffer, so this stops at the end of this macro
+    send_string_eeprom_macro(p, end);
+#endif
 }
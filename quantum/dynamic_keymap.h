@@ -34,6 +34,16 @@ void     dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// With DYNAMIC_KEYMAP_RAM_MIRROR, the keymap layers are served from a RAM copy
+// and changes are written back to EEPROM by dynamic_keymap_task().
+// dynamic_keymap_flush() writes back all pending changes immediately.
+// dynamic_keymap_mirror_invalidate() must be called whenever the EEPROM is erased.
+void dynamic_keymap_task(void);
+void dynamic_keymap_flush(void);
+void dynamic_keymap_mirror_invalidate(void);
+#endif
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include "eeprom.h"
 #include "eeconfig.h"
 #include "action_layer.h"
@@ -12,12 +13,149 @@
 #    include "haptic.h"
 #endif
 
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+#    include "dynamic_keymap.h"
+#endif
+
 #if defined(VIA_ENABLE)
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
 void eeconfig_init_via(void);
 #endif
 
+#ifdef EECONFIG_WRITE_BEHIND
+#    include "timer.h"
+
+// The eeconfig area is mirrored in RAM. Updates change the mirror immediately and are written
+// back to EEPROM once no further updates have happened for EECONFIG_FLUSH_DELAY milliseconds.
+#    ifndef EECONFIG_FLUSH_DELAY
+#        define EECONFIG_FLUSH_DELAY 100
+#    endif
+
+// Maximum number of bytes written to EEPROM per call of eeconfig_task()
+#    ifndef EECONFIG_FLUSH_SIZE
+#        define EECONFIG_FLUSH_SIZE 8
+#    endif
+
+static uint8_t  eeconfig_cache[EECONFIG_SIZE];
+static uint8_t  eeconfig_dirty[(EECONFIG_SIZE + 7) / 8];
+static bool     eeconfig_cache_loaded = false;
+static bool     eeconfig_has_dirty    = false;
+static uint16_t eeconfig_last_write   = 0;
+
+static void eeconfig_cache_load(void) {
+    if (!eeconfig_cache_loaded) {
+        eeprom_read_block(eeconfig_cache, (const void *)0, EECONFIG_SIZE);
+        eeconfig_cache_loaded = true;
+    }
+}
+
+#    if defined(EEPROM_DRIVER)
+// Drops pending updates, used once the EEPROM itself has been erased
+static void eeconfig_cache_discard(void) {
+    memset(eeconfig_dirty, 0, sizeof(eeconfig_dirty));
+    eeconfig_has_dirty    = false;
+    eeconfig_cache_loaded = false;
+}
+#    endif
+
+static inline bool eeconfig_is_dirty(uint16_t offset) {
+    return eeconfig_dirty[offset / 8] & (1 << (offset % 8));
+}
+
+void eeconfig_read_block(void *buf, const void *addr, size_t len) {
+    uintptr_t offset = (uintptr_t)addr;
+    uint8_t * dest   = (uint8_t *)buf;
+    eeconfig_cache_load();
+    for (; len > 0 && offset < EECONFIG_SIZE; len--) {
+        *dest++ = eeconfig_cache[offset++];
+    }
+    // Anything past the eeconfig area is not mirrored
+    if (len > 0) {
+        eeprom_read_block(dest, (const void *)offset, len);
+    }
+}
+
+void eeconfig_update_block(const void *buf, void *addr, size_t len) {
+    uintptr_t      offset = (uintptr_t)addr;
+    const uint8_t *src    = (const uint8_t *)buf;
+    eeconfig_cache_load();
+    for (; len > 0 && offset < EECONFIG_SIZE; len--, offset++, src++) {
+        if (eeconfig_cache[offset] != *src) {
+            eeconfig_cache[offset] = *src;
+            eeconfig_dirty[offset / 8] |= 1 << (offset % 8);
+            eeconfig_has_dirty  = true;
+            eeconfig_last_write = timer_read();
+        }
+    }
+    if (len > 0) {
+        eeprom_update_block(src, (void *)offset, len);
+    }
+}
+
+uint8_t eeconfig_read_byte(const uint8_t *addr) {
+    uint8_t ret = 0;
+    eeconfig_read_block(&ret, addr, 1);
+    return ret;
+}
+
+uint16_t eeconfig_read_word(const uint16_t *addr) {
+    uint16_t ret = 0;
+    eeconfig_read_block(&ret, addr, 2);
+    return ret;
+}
+
+uint32_t eeconfig_read_dword(const uint32_t *addr) {
+    uint32_t ret = 0;
+    eeconfig_read_block(&ret, addr, 4);
+    return ret;
+}
+
+void eeconfig_update_byte(uint8_t *addr, uint8_t value) {
+    eeconfig_update_block(&value, addr, 1);
+}
+
+void eeconfig_update_word(uint16_t *addr, uint16_t value) {
+    eeconfig_update_block(&value, addr, 2);
+}
+
+void eeconfig_update_dword(uint32_t *addr, uint32_t value) {
+    eeconfig_update_block(&value, addr, 4);
+}
+
+// Writes back the first run of dirty bytes, at most EECONFIG_FLUSH_SIZE bytes of it.
+// Returns false once nothing is left to write.
+static bool eeconfig_flush_chunk(void) {
+    uint16_t start = 0;
+    while (start < EECONFIG_SIZE && !eeconfig_is_dirty(start)) {
+        start++;
+    }
+    if (start == EECONFIG_SIZE) {
+        eeconfig_has_dirty = false;
+        return false;
+    }
+
+    uint16_t end = start;
+    while (end < EECONFIG_SIZE && end - start < EECONFIG_FLUSH_SIZE && eeconfig_is_dirty(end)) {
+        eeconfig_dirty[end / 8] &= ~(1 << (end % 8));
+        end++;
+    }
+    eeprom_update_block(&eeconfig_cache[start], (void *)(uintptr_t)start, end - start);
+    return true;
+}
+
+void eeconfig_flush(void) {
+    while (eeconfig_flush_chunk()) {
+    }
+}
+
+void eeconfig_task(void) {
+    if (eeconfig_has_dirty && timer_elapsed(eeconfig_last_write) >= EECONFIG_FLUSH_DELAY) {
+        eeconfig_flush_chunk();
+    }
+}
+#endif
+
 /** \brief eeconfig enable
  *
  * FIXME: needs doc
@@ -40,31 +178,37 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
 void eeconfig_init_quantum(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+#    ifdef EECONFIG_WRITE_BEHIND
+    eeconfig_cache_discard();
+#    endif
+#    if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_mirror_invalidate();
+#    endif
 #endif
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
-    eeprom_update_byte(EECONFIG_DEBUG, 0);
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, 0);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_update_byte(EECONFIG_DEBUG, 0);
+    eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, 0);
     default_layer_state = 0;
-    eeprom_update_byte(EECONFIG_KEYMAP_LOWER_BYTE, 0);
-    eeprom_update_byte(EECONFIG_KEYMAP_UPPER_BYTE, 0);
-    eeprom_update_byte(EECONFIG_MOUSEKEY_ACCEL, 0);
-    eeprom_update_byte(EECONFIG_BACKLIGHT, 0);
-    eeprom_update_byte(EECONFIG_AUDIO, 0xFF); // On by default
-    eeprom_update_dword(EECONFIG_RGBLIGHT, 0);
-    eeprom_update_byte(EECONFIG_STENOMODE, 0);
-    eeprom_update_dword(EECONFIG_HAPTIC, 0);
-    eeprom_update_byte(EECONFIG_VELOCIKEY, 0);
-    eeprom_update_dword(EECONFIG_RGB_MATRIX, 0);
-    eeprom_update_word(EECONFIG_RGB_MATRIX_EXTENDED, 0);
+    eeconfig_update_byte(EECONFIG_KEYMAP_LOWER_BYTE, 0);
+    eeconfig_update_byte(EECONFIG_KEYMAP_UPPER_BYTE, 0);
+    eeconfig_update_byte(EECONFIG_MOUSEKEY_ACCEL, 0);
+    eeconfig_update_byte(EECONFIG_BACKLIGHT, 0);
+    eeconfig_update_byte(EECONFIG_AUDIO, 0xFF); // On by default
+    eeconfig_update_dword(EECONFIG_RGBLIGHT, 0);
+    eeconfig_update_byte(EECONFIG_STENOMODE, 0);
+    eeconfig_update_dword(EECONFIG_HAPTIC, 0);
+    eeconfig_update_byte(EECONFIG_VELOCIKEY, 0);
+    eeconfig_update_dword(EECONFIG_RGB_MATRIX, 0);
+    eeconfig_update_word(EECONFIG_RGB_MATRIX_EXTENDED, 0);
 
     // TODO: Remove once ARM has a way to configure EECONFIG_HANDEDNESS
     //        within the emulated eeprom via dfu-util or another tool
 #if defined INIT_EE_HANDS_LEFT
 #    pragma message "Faking EE_HANDS for left hand"
-    eeprom_update_byte(EECONFIG_HANDEDNESS, 1);
+    eeconfig_update_byte(EECONFIG_HANDEDNESS, 1);
 #elif defined INIT_EE_HANDS_RIGHT
 #    pragma message "Faking EE_HANDS for right hand"
-    eeprom_update_byte(EECONFIG_HANDEDNESS, 0);
+    eeconfig_update_byte(EECONFIG_HANDEDNESS, 0);
 #endif
 
 #if defined(HAPTIC_ENABLE)
@@ -73,7 +217,7 @@ void eeconfig_init_quantum(void) {
     // this is used in case haptic is disabled, but we still want sane defaults
     // in the haptic configuration eeprom. All zero will trigger a haptic_reset
     // when a haptic-enabled firmware is loaded onto the keyboard.
-    eeprom_update_dword(EECONFIG_HAPTIC, 0);
+    eeconfig_update_dword(EECONFIG_HAPTIC, 0);
 #endif
 #if defined(VIA_ENABLE)
     // Invalidate VIA eeprom config, and then reset.
@@ -99,7 +243,7 @@ void eeconfig_init(void) {
  * FIXME: needs doc
  */
 void eeconfig_enable(void) {
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
 }
 
 /** \brief eeconfig disable
@@ -109,8 +253,14 @@ void eeconfig_enable(void) {
 void eeconfig_disable(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+#    ifdef EECONFIG_WRITE_BEHIND
+    eeconfig_cache_discard();
+#    endif
+#    if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_mirror_invalidate();
+#    endif
 #endif
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
 }
 
 /** \brief eeconfig is enabled
@@ -118,7 +268,7 @@ void eeconfig_disable(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_enabled(void) {
-    bool is_eeprom_enabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
+    bool is_eeprom_enabled = (eeconfig_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
 #ifdef VIA_ENABLE
     if (is_eeprom_enabled) {
         is_eeprom_enabled = via_eeprom_is_valid();
@@ -132,7 +282,7 @@ bool eeconfig_is_enabled(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_disabled(void) {
-    bool is_eeprom_disabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
+    bool is_eeprom_disabled = (eeconfig_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
 #ifdef VIA_ENABLE
     if (!is_eeprom_disabled) {
         is_eeprom_disabled = !via_eeprom_is_valid();
@@ -146,14 +296,14 @@ bool eeconfig_is_disabled(void) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_debug(void) {
-    return eeprom_read_byte(EECONFIG_DEBUG);
+    return eeconfig_read_byte(EECONFIG_DEBUG);
 }
 /** \brief eeconfig update debug
  *
  * FIXME: needs doc
  */
 void eeconfig_update_debug(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEBUG, val);
+    eeconfig_update_byte(EECONFIG_DEBUG, val);
 }
 
 /** \brief eeconfig read default layer
@@ -161,14 +311,14 @@ void eeconfig_update_debug(uint8_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_default_layer(void) {
-    return eeprom_read_byte(EECONFIG_DEFAULT_LAYER);
+    return eeconfig_read_byte(EECONFIG_DEFAULT_LAYER);
 }
 /** \brief eeconfig update default layer
  *
  * FIXME: needs doc
  */
 void eeconfig_update_default_layer(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, val);
+    eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, val);
 }
 
 /** \brief eeconfig read keymap
@@ -176,15 +326,15 @@ void eeconfig_update_default_layer(uint8_t val) {
  * FIXME: needs doc
  */
 uint16_t eeconfig_read_keymap(void) {
-    return (eeprom_read_byte(EECONFIG_KEYMAP_LOWER_BYTE) | (eeprom_read_byte(EECONFIG_KEYMAP_UPPER_BYTE) << 8));
+    return (eeconfig_read_byte(EECONFIG_KEYMAP_LOWER_BYTE) | (eeconfig_read_byte(EECONFIG_KEYMAP_UPPER_BYTE) << 8));
 }
 /** \brief eeconfig update keymap
  *
  * FIXME: needs doc
  */
 void eeconfig_update_keymap(uint16_t val) {
-    eeprom_update_byte(EECONFIG_KEYMAP_LOWER_BYTE, val & 0xFF);
-    eeprom_update_byte(EECONFIG_KEYMAP_UPPER_BYTE, (val >> 8) & 0xFF);
+    eeconfig_update_byte(EECONFIG_KEYMAP_LOWER_BYTE, val & 0xFF);
+    eeconfig_update_byte(EECONFIG_KEYMAP_UPPER_BYTE, (val >> 8) & 0xFF);
 }
 
 /** \brief eeconfig read audio
@@ -192,14 +342,14 @@ void eeconfig_update_keymap(uint16_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_audio(void) {
-    return eeprom_read_byte(EECONFIG_AUDIO);
+    return eeconfig_read_byte(EECONFIG_AUDIO);
 }
 /** \brief eeconfig update audio
  *
  * FIXME: needs doc
  */
 void eeconfig_update_audio(uint8_t val) {
-    eeprom_update_byte(EECONFIG_AUDIO, val);
+    eeconfig_update_byte(EECONFIG_AUDIO, val);
 }
 
 /** \brief eeconfig read kb
@@ -207,14 +357,14 @@ void eeconfig_update_audio(uint8_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_kb(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD);
+    return eeconfig_read_dword(EECONFIG_KEYBOARD);
 }
 /** \brief eeconfig update kb
  *
  * FIXME: needs doc
  */
 void eeconfig_update_kb(uint32_t val) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, val);
+    eeconfig_update_dword(EECONFIG_KEYBOARD, val);
 }
 
 /** \brief eeconfig read user
@@ -222,14 +372,14 @@ void eeconfig_update_kb(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_user(void) {
-    return eeprom_read_dword(EECONFIG_USER);
+    return eeconfig_read_dword(EECONFIG_USER);
 }
 /** \brief eeconfig update user
  *
  * FIXME: needs doc
  */
 void eeconfig_update_user(uint32_t val) {
-    eeprom_update_dword(EECONFIG_USER, val);
+    eeconfig_update_dword(EECONFIG_USER, val);
 }
 
 /** \brief eeconfig read haptic
@@ -237,14 +387,14 @@ void eeconfig_update_user(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_haptic(void) {
-    return eeprom_read_dword(EECONFIG_HAPTIC);
+    return eeconfig_read_dword(EECONFIG_HAPTIC);
 }
 /** \brief eeconfig update haptic
  *
  * FIXME: needs doc
  */
 void eeconfig_update_haptic(uint32_t val) {
-    eeprom_update_dword(EECONFIG_HAPTIC, val);
+    eeconfig_update_dword(EECONFIG_HAPTIC, val);
 }
 
 /** \brief eeconfig read split handedness
@@ -252,12 +402,12 @@ void eeconfig_update_haptic(uint32_t val) {
  * FIXME: needs doc
  */
 bool eeconfig_read_handedness(void) {
-    return !!eeprom_read_byte(EECONFIG_HANDEDNESS);
+    return !!eeconfig_read_byte(EECONFIG_HANDEDNESS);
 }
 /** \brief eeconfig update split handedness
  *
  * FIXME: needs doc
  */
 void eeconfig_update_handedness(bool val) {
-    eeprom_update_byte(EECONFIG_HANDEDNESS, !!val);
+    eeconfig_update_byte(EECONFIG_HANDEDNESS, !!val);
 }
@@ -19,6 +19,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifndef EECONFIG_MAGIC_NUMBER
 #    define EECONFIG_MAGIC_NUMBER (uint16_t)0xFEE9 // When changing, decrement this value to avoid future re-init issues
@@ -112,16 +113,41 @@ void     eeconfig_update_haptic(uint32_t val);
 bool eeconfig_read_handedness(void);
 void eeconfig_update_handedness(bool val);
 
+#ifdef EECONFIG_WRITE_BEHIND
+// With EECONFIG_WRITE_BEHIND, the first EECONFIG_SIZE bytes of EEPROM are served from a RAM copy
+// and updates are written back to EEPROM in small slices by eeconfig_task().
+// eeconfig_flush() writes back all pending changes immediately.
+uint8_t  eeconfig_read_byte(const uint8_t *addr);
+uint16_t eeconfig_read_word(const uint16_t *addr);
+uint32_t eeconfig_read_dword(const uint32_t *addr);
+void     eeconfig_read_block(void *buf, const void *addr, size_t len);
+void     eeconfig_update_byte(uint8_t *addr, uint8_t value);
+void     eeconfig_update_word(uint16_t *addr, uint16_t value);
+void     eeconfig_update_dword(uint32_t *addr, uint32_t value);
+void     eeconfig_update_block(const void *buf, void *addr, size_t len);
+void     eeconfig_task(void);
+void     eeconfig_flush(void);
+#else
+#    define eeconfig_read_byte eeprom_read_byte
+#    define eeconfig_read_word eeprom_read_word
+#    define eeconfig_read_dword eeprom_read_dword
+#    define eeconfig_read_block eeprom_read_block
+#    define eeconfig_update_byte eeprom_update_byte
+#    define eeconfig_update_word eeprom_update_word
+#    define eeconfig_update_dword eeprom_update_dword
+#    define eeconfig_update_block eeprom_update_block
+#endif
+
 #define EECONFIG_DEBOUNCE_HELPER(name, offset, config)                  \
     static uint8_t dirty_##name = false;                                \
                                                                         \
     static inline void eeconfig_init_##name(void) {                     \
-        eeprom_read_block(&config, offset, sizeof(config));             \
+        eeconfig_read_block(&config, offset, sizeof(config));           \
         dirty_##name = false;                                           \
     }                                                                   \
     static inline void eeconfig_flush_##name(bool force) {              \
         if (force || dirty_##name) {                                    \
-            eeprom_update_block(&config, offset, sizeof(config));       \
+            eeconfig_update_block(&config, offset, sizeof(config));     \
             dirty_##name = false;                                       \
         }                                                               \
     }                                                                   \
@@ -75,6 +75,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OLED_ENABLE
 #    include "oled_driver.h"
 #endif
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_master.h"
+#endif
 #ifdef ST7565_ENABLE
 #    include "st7565.h"
 #endif
@@ -108,6 +111,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef BLUETOOTH_ENABLE
 #    include "outputselect.h"
 #endif
+#include "scan_stats.h"
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -374,6 +378,9 @@ void keyboard_init(void) {
 #if defined(CRC_ENABLE)
     crc_init();
 #endif
+#ifdef SCAN_STATS_ENABLE
+    scan_stats_clear();
+#endif
 #ifdef OLED_ENABLE
     oled_init(OLED_ROTATION_0);
 #endif
@@ -438,60 +445,95 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 
 /** \brief Perform scan of keyboard matrix
  *
- * Any detected changes in state are sent out as part of the processing
+ * Every key whose state changed since the last scan is turned into a key event
+ * and handed to action_exec() in the same task call, so chords are reported
+ * without waiting for further keyboard_task() iterations. All events of a scan
+ * share the timestamp captured right after matrix_scan() returned, so tapping
+ * and combo timing is based on when the switches were read rather than on how
+ * long processing of the earlier events took. With SERIAL_USART_PUSH, events
+ * from the other half of a split keyboard carry the time that half scanned them,
+ * but never a time earlier than an event that has already been dispatched.
+ *
+ * Defining QMK_KEYS_PER_SCAN caps the number of events processed per call; any
+ * remaining changes are picked up on the next scan.
  */
 bool matrix_scan_task(void) {
     static matrix_row_t matrix_prev[MATRIX_ROWS];
+#if defined(SPLIT_KEYBOARD) && defined(SERIAL_USART_PUSH) && !defined(DISABLE_SYNC_TIMER)
+    static uint16_t last_event_time = 0;
+#endif
     matrix_row_t        matrix_row    = 0;
     matrix_row_t        matrix_change = 0;
+    bool                key_processed = false;
 #ifdef QMK_KEYS_PER_SCAN
     uint8_t keys_processed = 0;
 #endif
 
+    scan_stats_start(SCAN_STATS_MATRIX_SCAN);
     uint8_t matrix_changed = matrix_scan();
+    scan_stats_stop(SCAN_STATS_MATRIX_SCAN);
     if (matrix_changed) last_matrix_activity_trigger();
 
+    scan_stats_start(SCAN_STATS_KEY_EVENTS);
+
+    const uint16_t scan_time = timer_read() | 1; /* time should not be 0 */
+#if defined(SPLIT_KEYBOARD) && defined(SERIAL_USART_PUSH) && !defined(DISABLE_SYNC_TIMER)
+    const uint16_t slave_scan_time = split_slave_matrix_scan_time(scan_time) | 1;
+#endif
+
     for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
         matrix_row    = matrix_get_row(r);
         matrix_change = matrix_row ^ matrix_prev[r];
-        if (matrix_change) {
+        if (!matrix_change) {
+            continue;
+        }
 #ifdef MATRIX_HAS_GHOST
-            if (has_ghost_in_row(r, matrix_row)) {
-                continue;
-            }
+        if (has_ghost_in_row(r, matrix_row)) {
+            continue;
+        }
 #endif
-            if (debug_matrix) matrix_print();
-            matrix_row_t col_mask = 1;
-            for (uint8_t c = 0; c < MATRIX_COLS; c++, col_mask <<= 1) {
-                if (matrix_change & col_mask) {
-                    if (should_process_keypress()) {
-                        action_exec((keyevent_t){
-                            .key = (keypos_t){.row = r, .col = c}, .pressed = (matrix_row & col_mask), .time = (timer_read() | 1) /* time should not be 0 */
-                        });
+        if (debug_matrix) matrix_print();
+        matrix_row_t col_mask = 1;
+        for (uint8_t c = 0; c < MATRIX_COLS; c++, col_mask <<= 1) {
+            if (matrix_change & col_mask) {
+                if (should_process_keypress()) {
+#if defined(SPLIT_KEYBOARD) && defined(SERIAL_USART_PUSH) && !defined(DISABLE_SYNC_TIMER)
+                    uint16_t event_time = is_keyboard_left() == (r < MATRIX_ROWS / 2) ? scan_time : slave_scan_time;
+                    // Keys left over by QMK_KEYS_PER_SCAN reuse a slave scan time that can predate
+                    // events already processed, and tapping relies on time never going backwards
+                    if (last_event_time && !timer_expired(event_time, last_event_time)) {
+                        event_time = last_event_time;
                     }
-                    // record a processed key
-                    matrix_prev[r] ^= col_mask;
+                    last_event_time = event_time;
+#else
+                    const uint16_t event_time = scan_time;
+#endif
+                    action_exec((keyevent_t){.key = (keypos_t){.row = r, .col = c}, .pressed = (matrix_row & col_mask), .time = event_time});
+                }
+                // record a processed key
+                matrix_prev[r] ^= col_mask;
 
-                    switch_events(r, c, (matrix_row & col_mask));
+                switch_events(r, c, (matrix_row & col_mask));
 
+                key_processed = true;
 #ifdef QMK_KEYS_PER_SCAN
-                    // only jump out if we have processed "enough" keys.
-                    if (++keys_processed >= QMK_KEYS_PER_SCAN)
-#endif
-                        // process a key per task call
-                        goto MATRIX_LOOP_END;
+                // leave the rest of the changes for the next scan
+                if (++keys_processed >= QMK_KEYS_PER_SCAN) {
+                    goto MATRIX_LOOP_END;
                 }
+#endif
             }
         }
     }
-    // call with pseudo tick event when no real key event.
+
 #ifdef QMK_KEYS_PER_SCAN
-    // we can get here with some keys processed now.
-    if (!keys_processed)
+MATRIX_LOOP_END:
 #endif
+    // call with pseudo tick event when no real key event.
+    if (!key_processed) {
         action_exec(TICK);
-
-MATRIX_LOOP_END:
+    }
+    scan_stats_stop(SCAN_STATS_KEY_EVENTS);
 
     matrix_scan_perf_task();
     return matrix_changed;
@@ -539,6 +581,14 @@ void quantum_task(void) {
     sequencer_task();
 #endif
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_task();
+#endif
+
+#if defined(UNICODE_COMMON_ENABLE) && defined(UNICODE_STREAM_ENABLE)
+    unicode_stream_task();
+#endif
+
 #ifdef TAP_DANCE_ENABLE
     tap_dance_task();
 #endif
@@ -576,10 +626,19 @@ void quantum_task(void) {
  * This is repeatedly called as fast as possible.
  */
 void keyboard_task(void) {
+    scan_stats_start(SCAN_STATS_KEYBOARD_TASK);
+
     bool matrix_changed = matrix_scan_task();
     (void)matrix_changed;
 
+#ifdef I2C_ASYNC_ENABLE
+    // Results of the transfers sent in the background since the last task
+    i2c_async_task();
+#endif
+
+    scan_stats_start(SCAN_STATS_QUANTUM_TASK);
     quantum_task();
+    scan_stats_stop(SCAN_STATS_QUANTUM_TASK);
 
 #if defined(RGBLIGHT_ENABLE)
     rgblight_task();
@@ -589,7 +648,9 @@ void keyboard_task(void) {
     led_matrix_task();
 #endif
 #ifdef RGB_MATRIX_ENABLE
+    scan_stats_start(SCAN_STATS_RGB_MATRIX_TASK);
     rgb_matrix_task();
+    scan_stats_stop(SCAN_STATS_RGB_MATRIX_TASK);
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
@@ -604,7 +665,9 @@ void keyboard_task(void) {
 #endif
 
 #ifdef OLED_ENABLE
+    scan_stats_start(SCAN_STATS_OLED_TASK);
     oled_task();
+    scan_stats_stop(SCAN_STATS_OLED_TASK);
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
 #        ifdef ENCODER_ENABLE
@@ -637,7 +700,9 @@ void keyboard_task(void) {
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
+    scan_stats_start(SCAN_STATS_POINTING_DEVICE_TASK);
     pointing_device_task();
+    scan_stats_stop(SCAN_STATS_POINTING_DEVICE_TASK);
 #endif
 
 #ifdef MIDI_ENABLE
@@ -662,5 +727,20 @@ void keyboard_task(void) {
     programmable_button_send();
 #endif
 
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_task();
+#endif
+
+#ifdef EECONFIG_WRITE_BEHIND
+    eeconfig_task();
+#endif
+
+#ifdef EEPROM_WEAR_LEVELING
+    eeprom_driver_task();
+#endif
+
     led_task();
+
+    scan_stats_stop(SCAN_STATS_KEYBOARD_TASK);
+    scan_stats_task();
 }
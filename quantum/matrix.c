@@ -337,10 +337,14 @@ uint8_t matrix_scan(void) {
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
 #ifdef SPLIT_KEYBOARD
-    debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed);
+    if (debounce_required(changed)) {
+        debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed);
+    }
     changed = (changed || matrix_post_scan());
 #else
-    debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+    if (debounce_required(changed)) {
+        debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+    }
     matrix_scan_quantum();
 #endif
     return (uint8_t)changed;
@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "print.h"
 #include "process_combo.h"
 #include "action_tapping.h"
@@ -88,6 +89,28 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_INDEX_LENGTH
+/* Inverted index from keycode to the combos containing it, sorted by keycode
+ * and combo index, so only combos that contain the processed keycode have to
+ * be looked at. It is built on first use and whenever COMBO_LEN changes. If
+ * the combos have more keys than COMBO_INDEX_LENGTH, all combos are scanned. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_index_entry_t;
+static combo_index_entry_t combo_index[COMBO_INDEX_LENGTH];
+static uint16_t            combo_index_size    = 0;
+static uint16_t            combo_index_built   = 0;
+static bool                combo_index_ready   = false;
+static bool                combo_index_is_used = false;
+
+/* Combos whose state may be non-zero; only these need to be reset by clear_combos(). */
+static uint8_t combo_touched[(COMBO_INDEX_LENGTH + 7) / 8];
+
+#    define COMBO_TOUCH(index) (combo_touched[(index) / 8] |= (1 << ((index) % 8)))
+#    define COMBO_UNTOUCH(index) (combo_touched[(index) / 8] &= ~(1 << ((index) % 8)))
+#endif
+
 #define COMBO_KEY_POS ((keypos_t){.col = 254, .row = 254})
 
 #ifndef EXTRA_SHORT_COMBOS
@@ -195,6 +218,23 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_INDEX_LENGTH
+    if (combo_index_is_used) {
+        for (uint16_t i = 0; i < (COMBO_LEN + 7) / 8; ++i) {
+            if (!combo_touched[i]) {
+                continue;
+            }
+            for (index = i * 8; index < (i + 1) * 8 && index < COMBO_LEN; ++index) {
+                combo_t *combo = &key_combos[index];
+                if (!COMBO_ACTIVE(combo)) {
+                    RESET_COMBO_STATE(combo);
+                    COMBO_UNTOUCH(index);
+                }
+            }
+        }
+        return;
+    }
+#endif
     for (index = 0; index < COMBO_LEN; ++index) {
         combo_t *combo = &key_combos[index];
         if (!COMBO_ACTIVE(combo)) {
@@ -525,6 +565,65 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+#ifdef COMBO_INDEX_LENGTH
+static void combo_index_build(void) {
+    combo_index_size    = 0;
+    combo_index_built   = COMBO_LEN;
+    combo_index_ready   = true;
+    combo_index_is_used = false;
+
+    if (COMBO_LEN > COMBO_INDEX_LENGTH) {
+        return;
+    }
+
+    for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
+        const uint16_t *keys = key_combos[idx].keys;
+        uint16_t        key;
+        for (uint8_t key_i = 0; (key = pgm_read_word(&keys[key_i])) != COMBO_END; ++key_i) {
+            if (combo_index_size >= COMBO_INDEX_LENGTH) {
+                // index too small, fall back to scanning all combos
+                return;
+            }
+
+            // insertion sort by keycode, then combo index, skipping duplicate keys within a combo
+            uint16_t pos = combo_index_size;
+            while (pos > 0 && combo_index[pos - 1].keycode > key) {
+                pos--;
+            }
+            if (pos > 0 && combo_index[pos - 1].keycode == key && combo_index[pos - 1].combo_index == idx) {
+                continue;
+            }
+            for (uint16_t i = combo_index_size; i > pos; --i) {
+                combo_index[i] = combo_index[i - 1];
+            }
+            combo_index[pos] = (combo_index_entry_t){.keycode = key, .combo_index = idx};
+            combo_index_size++;
+        }
+    }
+
+    // all combos are reachable through the index, so the touched set can track them
+    memset(combo_touched, 0, sizeof(combo_touched));
+    for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
+        COMBO_TOUCH(idx);
+    }
+    combo_index_is_used = true;
+}
+
+/* Returns the position of the first index entry for the keycode, or combo_index_size. */
+static uint16_t combo_index_find(uint16_t keycode) {
+    uint16_t lo = 0, hi = combo_index_size;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (combo_index[mid].keycode < keycode) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+#endif
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
     bool is_combo_key          = false;
     bool no_combo_keys_pressed = true;
@@ -549,10 +648,25 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     keycode = keymap_key_to_keycode(COMBO_ONLY_FROM_LAYER, record->event.key);
 #endif
 
-    for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
-        combo_t *combo = &key_combos[idx];
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEX_LENGTH
+    if (!combo_index_ready || combo_index_built != COMBO_LEN) {
+        combo_index_build();
+    }
+    if (combo_index_is_used) {
+        for (uint16_t pos = combo_index_find(keycode); pos < combo_index_size && combo_index[pos].keycode == keycode; ++pos) {
+            uint16_t idx   = combo_index[pos].combo_index;
+            combo_t *combo = &key_combos[idx];
+            COMBO_TOUCH(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
+            combo_t *combo = &key_combos[idx];
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -26,7 +26,7 @@
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
 #endif
 
-// For benchmarking the time it takes to call process_key_override on every key press (needs keyboard debugging enabled as well)
+// For benchmarking the time it takes to call process_key_override on every key press (needs keyboard debugging enabled as well to print each measurement)
 // #define BENCH_KEY_OVERRIDE
 
 // For debug output (needs keyboard debugging enabled as well)
@@ -84,6 +84,122 @@ static bool enabled = true;
 // Public variables
 __attribute__((weak)) const key_override_t **key_overrides = NULL;
 
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+// Overrides sorted by trigger keycode, then by their position in key_overrides, so only overrides whose trigger can be involved in an event need to be looked at. Built on first use and whenever key_overrides changes. If there are more overrides than KEY_OVERRIDE_INDEX_LENGTH, all overrides are checked.
+typedef struct {
+    uint16_t trigger;
+    uint8_t  index;
+    // Copies of the override's mod masks, to reject overrides without dereferencing them
+    uint8_t trigger_mods;
+    uint8_t negative_mod_mask;
+} key_override_index_entry_t;
+
+static key_override_index_entry_t key_override_index[KEY_OVERRIDE_INDEX_LENGTH];
+static uint8_t                    key_override_index_size  = 0;
+static const key_override_t **    key_override_index_built = NULL;
+static bool                       key_override_index_used  = false;
+
+static void key_override_index_build(void) {
+    key_override_index_size  = 0;
+    key_override_index_built = key_overrides;
+    key_override_index_used  = false;
+
+    if (key_overrides == NULL) {
+        return;
+    }
+
+    for (uint8_t i = 0; key_overrides[i] != NULL; i++) {
+        const key_override_t *const override = key_overrides[i];
+
+        if (key_override_index_size >= KEY_OVERRIDE_INDEX_LENGTH || i == UINT8_MAX) {
+            // Too many overrides for the index, check all of them instead
+            return;
+        }
+
+        uint8_t pos = key_override_index_size;
+        while (pos > 0 && key_override_index[pos - 1].trigger > override->trigger) {
+            key_override_index[pos] = key_override_index[pos - 1];
+            pos--;
+        }
+        key_override_index[pos] = (key_override_index_entry_t){
+            .trigger           = override->trigger,
+            .index             = i,
+            .trigger_mods      = override->trigger_mods,
+            .negative_mod_mask = override->negative_mod_mask,
+        };
+        key_override_index_size++;
+    }
+
+    key_override_index_used = true;
+}
+
+// Position of the first index entry with the given trigger, or key_override_index_size
+static uint8_t key_override_index_find(const uint16_t trigger) {
+    uint8_t lo = 0, hi = key_override_index_size;
+    while (lo < hi) {
+        uint8_t mid = lo + (hi - lo) / 2;
+        if (key_override_index[mid].trigger < trigger) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Iterates over the overrides of up to three triggers in key_overrides order
+typedef struct {
+    uint16_t trigger[3];
+    uint8_t  pos[3];
+    uint8_t  count;
+} key_override_cursor_t;
+
+static void key_override_cursor_add(key_override_cursor_t *cursor, const uint16_t trigger) {
+    for (uint8_t i = 0; i < cursor->count; i++) {
+        if (cursor->trigger[i] == trigger) {
+            return;
+        }
+    }
+    cursor->trigger[cursor->count] = trigger;
+    cursor->pos[cursor->count]     = key_override_index_find(trigger);
+    cursor->count++;
+}
+
+// Returns the index entry of the next candidate override, or NULL when there are none left
+static const key_override_index_entry_t *key_override_cursor_next(key_override_cursor_t *cursor) {
+    int8_t best = -1;
+    for (uint8_t i = 0; i < cursor->count; i++) {
+        const uint8_t pos = cursor->pos[i];
+        if (pos >= key_override_index_size || key_override_index[pos].trigger != cursor->trigger[i]) {
+            continue;
+        }
+        if (best < 0 || key_override_index[pos].index < key_override_index[cursor->pos[best]].index) {
+            best = i;
+        }
+    }
+    if (best < 0) {
+        return NULL;
+    }
+    return &key_override_index[cursor->pos[best]++];
+}
+#endif
+
+#ifdef BENCH_KEY_OVERRIDE
+static key_override_bench_t bench = {0};
+
+__attribute__((weak)) uint32_t key_override_bench_clock(void) {
+    return timer_read32();
+}
+
+const key_override_bench_t *key_override_get_bench(void) {
+    return &bench;
+}
+
+void key_override_reset_bench(void) {
+    bench = (key_override_bench_t){0};
+}
+#endif
+
 // Forward decls
 static const key_override_t *clear_active_override(const bool allow_reregister);
 
@@ -249,12 +365,43 @@ static bool try_activating_override(const uint16_t keycode, const uint8_t layer,
         return true;
     }
 
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+    if (key_override_index_built != key_overrides) {
+        key_override_index_build();
+    }
+
+    // Only the overrides triggered by this key, by the last non-mod key that is down or by mods alone can activate
+    key_override_cursor_t cursor = {.count = 0};
+    if (key_override_index_used) {
+        key_override_cursor_add(&cursor, keycode);
+        key_override_cursor_add(&cursor, last_key_down);
+        key_override_cursor_add(&cursor, KC_NO);
+    }
+#endif
+
     for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
+        const key_override_t *override;
 
-        // End of array
-        if (override == NULL) {
-            break;
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+        if (key_override_index_used) {
+            const key_override_index_entry_t *entry = key_override_cursor_next(&cursor);
+            if (entry == NULL) {
+                break;
+            }
+            // Neither mode of matching mods can succeed without any of the trigger mods down, or with a negative mod down
+            if ((entry->trigger_mods != 0 && (entry->trigger_mods & active_mods) == 0) || (entry->negative_mod_mask & active_mods) != 0) {
+                continue;
+            }
+            override = key_overrides[entry->index];
+        } else
+#endif
+        {
+            override = key_overrides[i];
+
+            // End of array
+            if (override == NULL) {
+                break;
+            }
         }
 
         // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
@@ -398,7 +545,7 @@ void key_override_task(void) {
 
 bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
 #ifdef BENCH_KEY_OVERRIDE
-    uint16_t start = timer_read();
+    uint32_t start = key_override_bench_clock();
 #endif
 
     const bool key_down = record->event.pressed;
@@ -511,9 +658,15 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
     }
 
 #ifdef BENCH_KEY_OVERRIDE
-    uint16_t elapsed = timer_elapsed(start);
+    uint32_t elapsed = key_override_bench_clock() - start;
+
+    bench.events++;
+    bench.total += elapsed;
+    if (elapsed > bench.max) {
+        bench.max = elapsed;
+    }
 
-    dprintf("Processing key overrides took: %u ms\n", elapsed);
+    dprintf("Processing key overrides took: %lu\n", (unsigned long)elapsed);
 #endif
 
     return send_key_action;
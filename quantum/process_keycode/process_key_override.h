@@ -109,6 +109,24 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
 /** Perform any deferred keys */
 void key_override_task(void);
 
+#ifdef BENCH_KEY_OVERRIDE
+/** Time spent in process_key_override, in units of key_override_bench_clock() */
+typedef struct {
+    uint32_t events;
+    uint32_t total;
+    uint32_t max;
+} key_override_bench_t;
+
+/** Clock used for benchmarking. Defaults to timer_read32(), override it for a finer resolution. */
+uint32_t key_override_bench_clock(void);
+
+/** Returns the timings collected since start up or the last reset */
+const key_override_bench_t *key_override_get_bench(void);
+
+/** Clears the collected timings */
+void key_override_reset_bench(void);
+#endif
+
 /**
  *  Preferrably use these macros to create key overrides. They fix many of the options to a standard setting that should satisfy most basic use-cases. Only directly create a key_override_t struct when you really need to.
  */
@@ -31,7 +31,7 @@ static int8_t  selected_index;
 #endif
 
 void unicode_input_mode_init(void) {
-    unicode_config.raw = eeprom_read_byte(EECONFIG_UNICODEMODE);
+    unicode_config.raw = eeconfig_read_byte(EECONFIG_UNICODEMODE);
 #if UNICODE_SELECTED_MODES != -1
 #    if UNICODE_CYCLE_PERSIST
     // Find input_mode in selected modes
@@ -79,7 +79,7 @@ void cycle_unicode_input_mode(int8_t offset) {
 }
 
 void persist_unicode_input_mode(void) {
-    eeprom_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
+    eeconfig_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
 }
 
 __attribute__((weak)) void unicode_input_start(void) {
@@ -212,13 +212,11 @@ void register_hex32(uint32_t hex) {
     }
 }
 
-void register_unicode(uint32_t code_point) {
-    if (code_point > 0x10FFFF || (code_point > 0xFFFF && unicode_config.input_mode == UC_WIN)) {
-        // Code point out of range, do nothing
-        return;
-    }
+static bool is_code_point_supported(uint32_t code_point) {
+    return code_point <= 0x10FFFF && (code_point <= 0xFFFF || unicode_config.input_mode != UC_WIN);
+}
 
-    unicode_input_start();
+static void register_code_point_hex(uint32_t code_point) {
     if (code_point > 0xFFFF && unicode_config.input_mode == UC_MAC) {
         // Convert code point to UTF-16 surrogate pair on macOS
         code_point -= 0x10000;
@@ -228,6 +226,16 @@ void register_unicode(uint32_t code_point) {
     } else {
         register_hex32(code_point);
     }
+}
+
+void register_unicode(uint32_t code_point) {
+    if (!is_code_point_supported(code_point)) {
+        // Code point out of range, do nothing
+        return;
+    }
+
+    unicode_input_start();
+    register_code_point_hex(code_point);
     unicode_input_finish();
 }
 
@@ -306,6 +314,247 @@ void send_unicode_string(const char *str) {
     }
 }
 
+#ifdef UNICODE_STREAM_ENABLE
+typedef enum {
+    UNICODE_STREAM_IDLE,
+    UNICODE_STREAM_BEGIN,      // save lock states, start toggling Caps Lock off for UC_LNX
+    UNICODE_STREAM_LOCKS,      // finish the Caps Lock tap, turn Num Lock on for UC_WIN
+    UNICODE_STREAM_LEAD,       // start input of the next code point
+    UNICODE_STREAM_LEAD_TAP,   // UC_WIN: Keypad + once Alt has settled
+    UNICODE_STREAM_DIGITS,     // type the code point and commit it
+    UNICODE_STREAM_END,        // close the session, start restoring Caps Lock for UC_LNX
+    UNICODE_STREAM_RESTORE,    // finish the Caps Lock tap
+} unicode_stream_state_t;
+
+static const char *           unicode_stream_str   = NULL;
+static unicode_stream_state_t unicode_stream_state = UNICODE_STREAM_IDLE;
+static const char *           unicode_stream_code_point_str; // start of the code point being typed
+static uint32_t               unicode_stream_code_point;
+static uint16_t               unicode_stream_timer;
+static uint16_t               unicode_stream_delay = 0;
+// UC_MAC: Unicode Hex Input stays active for as long as Option is held
+static bool unicode_stream_session = false;
+// The mods of the user keep following the keys while the string is typed. The stream swaps in its own mods,
+// like the Option or Alt it holds, only while it sends reports.
+static uint8_t unicode_stream_mods = 0;
+static uint8_t unicode_stream_user_mods;
+
+static void unicode_stream_mods_begin(void) {
+    unicode_stream_user_mods = get_mods();
+    set_mods(unicode_stream_mods);
+}
+
+static void unicode_stream_mods_end(void) {
+    unicode_stream_mods = get_mods();
+    set_mods(unicode_stream_user_mods);
+}
+
+static void unicode_stream_wait(uint16_t ms) {
+    unicode_stream_timer = timer_read();
+    unicode_stream_delay = ms;
+}
+
+static bool unicode_stream_next_code_point(void) {
+    while (*unicode_stream_str) {
+        int32_t code_point            = 0;
+        unicode_stream_code_point_str = unicode_stream_str;
+        unicode_stream_str            = decode_utf8(unicode_stream_str, &code_point);
+        if (code_point >= 0 && is_code_point_supported(code_point)) {
+            unicode_stream_code_point = code_point;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool send_unicode_string_async(const char *str) {
+    if (!str || unicode_stream_state != UNICODE_STREAM_IDLE) {
+        return false;
+    }
+    unicode_stream_str   = str;
+    unicode_stream_state = UNICODE_STREAM_BEGIN;
+    unicode_stream_delay = 0;
+    return true;
+}
+
+bool unicode_stream_is_busy(void) {
+    return unicode_stream_state != UNICODE_STREAM_IDLE;
+}
+
+void unicode_stream_cancel(void) {
+    if (unicode_stream_state == UNICODE_STREAM_IDLE) {
+        return;
+    }
+
+    if (unicode_stream_state == UNICODE_STREAM_LEAD_TAP || unicode_stream_state == UNICODE_STREAM_DIGITS) {
+        // abandon the code point that was started
+        unicode_stream_mods_begin();
+        switch (unicode_config.input_mode) {
+            case UC_LNX:
+            case UC_WINC:
+                tap_code(KC_ESCAPE);
+                break;
+            case UC_WIN:
+                unregister_code(KC_LEFT_ALT);
+                break;
+        }
+        unicode_stream_mods_end();
+        unicode_stream_state = UNICODE_STREAM_LEAD;
+        unicode_stream_delay = 0;
+    }
+    // lock states are restored by the task as usual
+    unicode_stream_str = "";
+}
+
+// Any report sent for a key of the user releases the Option or Alt the stream holds, which ends
+// the input of the current code point. Release it right away and type that code point again.
+static void unicode_stream_interrupt(void) {
+    if (!unicode_stream_mods) {
+        return;
+    }
+    unicode_stream_mods    = 0;
+    unicode_stream_session = false;
+    send_keyboard_report();
+    if (unicode_stream_state == UNICODE_STREAM_LEAD_TAP || unicode_stream_state == UNICODE_STREAM_DIGITS) {
+        unicode_stream_str   = unicode_stream_code_point_str;
+        unicode_stream_state = UNICODE_STREAM_LEAD;
+        unicode_stream_delay = 0;
+    }
+}
+
+static void unicode_stream_step(void) {
+    while (unicode_stream_state != UNICODE_STREAM_IDLE) {
+        if (unicode_stream_delay && timer_elapsed(unicode_stream_timer) < unicode_stream_delay) {
+            return;
+        }
+        unicode_stream_delay = 0;
+
+        switch (unicode_stream_state) {
+            case UNICODE_STREAM_BEGIN:
+                unicode_saved_caps_lock = host_keyboard_led_state().caps_lock;
+                unicode_saved_num_lock  = host_keyboard_led_state().num_lock;
+                // Before the mods are cleared, see unicode_input_start()
+                if (unicode_config.input_mode == UC_LNX && unicode_saved_caps_lock) {
+                    register_code(KC_CAPS_LOCK);
+                    unicode_stream_wait(TAP_HOLD_CAPS_DELAY);
+                }
+                unicode_stream_state = UNICODE_STREAM_LOCKS;
+                break;
+
+            case UNICODE_STREAM_LOCKS:
+                if (unicode_config.input_mode == UC_LNX && unicode_saved_caps_lock) {
+                    unregister_code(KC_CAPS_LOCK);
+                }
+                if (unicode_config.input_mode == UC_WIN && !unicode_saved_num_lock) {
+                    tap_code(KC_NUM_LOCK);
+                }
+                unicode_stream_state = UNICODE_STREAM_LEAD;
+                break;
+
+            case UNICODE_STREAM_LEAD:
+                // Keys still held by the user would be combined with the input sequence
+                if (has_anykey(keyboard_report)) {
+                    return;
+                }
+                if (!unicode_stream_next_code_point()) {
+                    unicode_stream_state = UNICODE_STREAM_END;
+                    break;
+                }
+                unicode_stream_state = UNICODE_STREAM_DIGITS;
+                switch (unicode_config.input_mode) {
+                    case UC_MAC:
+                        if (unicode_stream_session) {
+                            // type straight away
+                            continue;
+                        }
+                        register_code(UNICODE_KEY_MAC);
+                        unicode_stream_session = true;
+                        break;
+                    case UC_LNX:
+                        tap_code16(UNICODE_KEY_LNX);
+                        break;
+                    case UC_WIN:
+                        register_code(KC_LEFT_ALT);
+                        unicode_stream_state = UNICODE_STREAM_LEAD_TAP;
+                        break;
+                    case UC_WINC:
+                        tap_code(UNICODE_KEY_WINC);
+                        tap_code(KC_U);
+                        break;
+                }
+                unicode_stream_wait(UNICODE_TYPE_DELAY);
+                break;
+
+            case UNICODE_STREAM_LEAD_TAP:
+                tap_code(KC_KP_PLUS);
+                unicode_stream_state = UNICODE_STREAM_DIGITS;
+                unicode_stream_wait(UNICODE_TYPE_DELAY);
+                break;
+
+            case UNICODE_STREAM_DIGITS:
+                register_code_point_hex(unicode_stream_code_point);
+                switch (unicode_config.input_mode) {
+                    case UC_LNX:
+                        tap_code(KC_SPACE);
+                        break;
+                    case UC_WIN:
+                        unregister_code(KC_LEFT_ALT);
+                        break;
+                    case UC_WINC:
+                        tap_code(KC_ENTER);
+                        break;
+                }
+                unicode_stream_state = UNICODE_STREAM_LEAD;
+                if (unicode_config.input_mode == UC_MAC) {
+                    // at most one code point per iteration
+                    return;
+                }
+                break;
+
+            case UNICODE_STREAM_END:
+                if (unicode_stream_session) {
+                    unregister_code(UNICODE_KEY_MAC);
+                    unicode_stream_session = false;
+                }
+                if (unicode_config.input_mode == UC_LNX && unicode_saved_caps_lock) {
+                    register_code(KC_CAPS_LOCK);
+                    unicode_stream_wait(TAP_HOLD_CAPS_DELAY);
+                }
+                if (unicode_config.input_mode == UC_WIN && !unicode_saved_num_lock) {
+                    tap_code(KC_NUM_LOCK);
+                }
+                unicode_stream_state = UNICODE_STREAM_RESTORE;
+                break;
+
+            case UNICODE_STREAM_RESTORE:
+                if (unicode_config.input_mode == UC_LNX && unicode_saved_caps_lock) {
+                    unregister_code(KC_CAPS_LOCK);
+                }
+                unicode_stream_str   = NULL;
+                unicode_stream_state = UNICODE_STREAM_IDLE;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+void unicode_stream_task(void) {
+    if (unicode_stream_state == UNICODE_STREAM_IDLE) {
+        return;
+    }
+
+    unicode_stream_mods_begin();
+    unicode_stream_step();
+    unicode_stream_mods_end();
+    // The reports of the stream left out the mods of the user, hand back those still held
+    if (unicode_stream_state == UNICODE_STREAM_IDLE && get_mods()) {
+        send_keyboard_report();
+    }
+}
+#endif
+
 // clang-format off
 
 static void audio_helper(void) {
@@ -348,6 +597,9 @@ static void audio_helper(void) {
 // clang-format on
 
 bool process_unicode_common(uint16_t keycode, keyrecord_t *record) {
+#ifdef UNICODE_STREAM_ENABLE
+    unicode_stream_interrupt();
+#endif
     if (record->event.pressed) {
         bool shifted = get_mods() & MOD_MASK_SHIFT;
         switch (keycode) {
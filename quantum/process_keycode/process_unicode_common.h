@@ -93,6 +93,18 @@ void register_unicode(uint32_t code_point);
 void send_unicode_hex_string(const char *str);
 void send_unicode_string(const char *str);
 
+#ifdef UNICODE_STREAM_ENABLE
+/** \brief Queues a UTF-8 string to be typed from keyboard_task(), returns false if one is still being typed
+ *
+ * The string is not copied and must stay valid until unicode_stream_is_busy() returns false.
+ */
+bool send_unicode_string_async(const char *str);
+bool unicode_stream_is_busy(void);
+/** \brief Abandons the code point being typed and stops, mods and lock states are still restored */
+void unicode_stream_cancel(void);
+void unicode_stream_task(void);
+#endif
+
 bool process_unicode_common(uint16_t keycode, keyrecord_t *record);
 
 #define UC_BSPC UC(0x0008)
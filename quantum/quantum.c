@@ -142,6 +142,12 @@ void reset_keyboard(void) {
 #endif
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
+#endif
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_flush();
+#endif
+#ifdef EECONFIG_WRITE_BEHIND
+    eeconfig_flush();
 #endif
     bootloader_jump();
 }
@@ -400,6 +406,12 @@ __attribute__((weak)) void shutdown_user() {}
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_flush();
+#endif
+#ifdef EECONFIG_WRITE_BEHIND
+    eeconfig_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
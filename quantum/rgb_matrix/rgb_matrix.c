@@ -35,6 +35,42 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Used by the generic effect runners. RGB_MATRIX_HSV_TO_RGB_BATCH skips rgb_matrix_hsv_to_rgb() for the faster
+// hsv_to_rgb_batch(), so keyboards overriding rgb_matrix_hsv_to_rgb() must not define it.
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+#ifdef RGB_MATRIX_HSV_TO_RGB_BATCH
+    hsv_to_rgb_batch(hsv, rgb, count);
+#else
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]);
+    }
+#endif
+}
+
+// Colors of several LEDs, converted and set together
+typedef struct {
+    HSV     hsv[RGB_MATRIX_HSV_BATCH_SIZE];
+    uint8_t led[RGB_MATRIX_HSV_BATCH_SIZE];
+    uint8_t count;
+} rgb_matrix_hsv_batch_t;
+
+static void rgb_matrix_hsv_batch_flush(rgb_matrix_hsv_batch_t *batch) {
+    RGB rgb[RGB_MATRIX_HSV_BATCH_SIZE];
+    rgb_matrix_hsv_to_rgb_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t i = 0; i < batch->count; i++) {
+        rgb_matrix_set_color(batch->led[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+    batch->count = 0;
+}
+
+static inline void rgb_matrix_hsv_batch_add(rgb_matrix_hsv_batch_t *batch, uint8_t led, HSV hsv) {
+    batch->hsv[batch->count] = hsv;
+    batch->led[batch->count] = led;
+    if (++batch->count == RGB_MATRIX_HSV_BATCH_SIZE) {
+        rgb_matrix_hsv_batch_flush(batch);
+    }
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -110,6 +146,22 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
 #    define RGB_MATRIX_STARTUP_SPD UINT8_MAX / 2
 #endif
 
+#if defined(RGB_MATRIX_RENDER_BUDGET_US) || defined(RGB_MATRIX_RENDER_STATS)
+// Render timing uses the ChibiOS system timer where available, the millisecond timer otherwise
+#    if defined(PROTOCOL_CHIBIOS)
+typedef systime_t rgb_render_time_t;
+#        define rgb_render_time_read() chVTGetSystemTimeX()
+#        define rgb_render_time_elapsed_us(start) ((uint32_t)TIME_I2US(chTimeDiffX((start), chVTGetSystemTimeX())))
+#    else
+typedef uint32_t rgb_render_time_t;
+#        define rgb_render_time_read() timer_read32()
+#        define rgb_render_time_elapsed_us(start) (timer_elapsed32(start) * 1000)
+#        if defined(RGB_MATRIX_RENDER_BUDGET_US) && RGB_MATRIX_RENDER_BUDGET_US < 1000
+#            error "RGB_MATRIX_RENDER_BUDGET_US below 1000 needs a microsecond timer, which is only available on ChibiOS"
+#        endif
+#    endif
+#endif
+
 // globals
 rgb_config_t rgb_matrix_config; // TODO: would like to prefix this with g_ for global consistancy, do this in another pr
 uint32_t     g_rgb_timer;
@@ -130,6 +182,11 @@ static rgb_task_states rgb_task_state    = SYNCING;
 static uint32_t rgb_anykey_timer;
 #endif // RGB_DISABLE_TIMEOUT > 0
 
+#ifdef RGB_MATRIX_RENDER_STATS
+static rgb_matrix_render_stats_t rgb_render_stats[RGB_MATRIX_EFFECT_MAX];
+static uint32_t                  rgb_render_frame_us = 0;
+#endif // RGB_MATRIX_RENDER_STATS
+
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -423,14 +480,42 @@ void rgb_matrix_task(void) {
         case STARTING:
             rgb_task_start();
             break;
-        case RENDERING:
-            rgb_task_render(effect);
-            if (effect) {
-                rgb_matrix_indicators();
-                rgb_matrix_indicators_advanced(&rgb_effect_params);
+        case RENDERING: {
+#if defined(RGB_MATRIX_RENDER_BUDGET_US) || defined(RGB_MATRIX_RENDER_STATS)
+            rgb_render_time_t render_start = rgb_render_time_read();
+#endif
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+            // Keep rendering chunks of the frame until it is done or the budget of this task run is spent
+            do {
+#endif
+                rgb_task_render(effect);
+                if (effect) {
+                    rgb_matrix_indicators();
+                    rgb_matrix_indicators_advanced(&rgb_effect_params);
+                }
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+            } while (rgb_task_state == RENDERING && rgb_render_time_elapsed_us(render_start) < RGB_MATRIX_RENDER_BUDGET_US);
+#endif
+#ifdef RGB_MATRIX_RENDER_STATS
+            rgb_render_frame_us += rgb_render_time_elapsed_us(render_start);
+            if (rgb_task_state != RENDERING) {
+                rgb_matrix_render_stats_t *stats = &rgb_render_stats[effect < RGB_MATRIX_EFFECT_MAX ? effect : RGB_MATRIX_NONE];
+                stats->frames++;
+                stats->total_us += rgb_render_frame_us;
+                if (rgb_render_frame_us > stats->max_us) {
+                    stats->max_us = rgb_render_frame_us;
+                }
+                rgb_render_frame_us = 0;
             }
-            break;
+#endif
+        } break;
         case FLUSHING:
+#if defined(WS2812) && defined(WS2812_DRIVER_PWM_ASYNC)
+            // The previous frame is still queued in the driver, try again on the next task call
+            if (!ws2812_ready()) {
+                break;
+            }
+#endif
             rgb_task_flush(effect);
             break;
         case SYNCING:
@@ -439,6 +524,16 @@ void rgb_matrix_task(void) {
     }
 }
 
+#ifdef RGB_MATRIX_RENDER_STATS
+const rgb_matrix_render_stats_t *rgb_matrix_get_render_stats(uint8_t mode) {
+    return mode < RGB_MATRIX_EFFECT_MAX ? &rgb_render_stats[mode] : NULL;
+}
+
+void rgb_matrix_reset_render_stats(void) {
+    memset(rgb_render_stats, 0, sizeof(rgb_render_stats));
+}
+#endif // RGB_MATRIX_RENDER_STATS
+
 void rgb_matrix_indicators(void) {
     rgb_matrix_indicators_kb();
     rgb_matrix_indicators_user();
@@ -46,6 +46,10 @@
 #    define RGB_MATRIX_LED_FLUSH_LIMIT 16
 #endif
 
+#ifndef RGB_MATRIX_HSV_BATCH_SIZE
+#    define RGB_MATRIX_HSV_BATCH_SIZE 16
+#endif
+
 #ifndef RGB_MATRIX_LED_PROCESS_LIMIT
 #    define RGB_MATRIX_LED_PROCESS_LIMIT (DRIVER_LED_TOTAL + 4) / 5
 #endif
@@ -122,10 +126,25 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+RGB  rgb_matrix_hsv_to_rgb(HSV hsv);
+void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count);
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
 
+#ifdef RGB_MATRIX_RENDER_STATS
+// Time spent rendering complete frames of an effect, including indicators
+typedef struct {
+    uint32_t frames;
+    uint32_t total_us;
+    uint32_t max_us;
+} rgb_matrix_render_stats_t;
+
+const rgb_matrix_render_stats_t *rgb_matrix_get_render_stats(uint8_t mode);
+void                             rgb_matrix_reset_render_stats(void);
+#endif
+
 // This runs after another backlight effect and replaces
 // colors already set
 void rgb_matrix_indicators(void);
@@ -338,11 +338,21 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 // LED color buffer
 LED_TYPE rgb_matrix_ws2812_array[DRIVER_LED_TOTAL];
 
+// One past the last LED whose color changed since the last flush. The chain
+// keeps the colors of the LEDs after the ones that were sent, so only this
+// prefix of the buffer needs to be sent. The first flush sends everything.
+static uint16_t rgb_matrix_ws2812_dirty_end = DRIVER_LED_TOTAL;
+
 static void init(void) {}
 
 static void flush(void) {
+    if (rgb_matrix_ws2812_dirty_end == 0) {
+        return;
+    }
+
     // Assumes use of RGB_DI_PIN
-    ws2812_setleds(rgb_matrix_ws2812_array, DRIVER_LED_TOTAL);
+    ws2812_setleds(rgb_matrix_ws2812_array, rgb_matrix_ws2812_dirty_end);
+    rgb_matrix_ws2812_dirty_end = 0;
 }
 
 // Set an led in the buffer to a color
@@ -360,12 +370,23 @@ static inline void setled(int i, uint8_t r, uint8_t g, uint8_t b) {
     }
 #    endif
 
-    rgb_matrix_ws2812_array[i].r = r;
-    rgb_matrix_ws2812_array[i].g = g;
-    rgb_matrix_ws2812_array[i].b = b;
+    LED_TYPE led = {.r = r, .g = g, .b = b};
 #    ifdef RGBW
-    convert_rgb_to_rgbw(&rgb_matrix_ws2812_array[i]);
+    // The buffer holds converted values, so compare against the converted color
+    convert_rgb_to_rgbw(&led);
+    if (rgb_matrix_ws2812_array[i].w == led.w && rgb_matrix_ws2812_array[i].r == led.r && rgb_matrix_ws2812_array[i].g == led.g && rgb_matrix_ws2812_array[i].b == led.b) {
+        return;
+    }
+#    else
+    if (rgb_matrix_ws2812_array[i].r == r && rgb_matrix_ws2812_array[i].g == g && rgb_matrix_ws2812_array[i].b == b) {
+        return;
+    }
 #    endif
+
+    rgb_matrix_ws2812_array[i] = led;
+    if (i >= rgb_matrix_ws2812_dirty_end) {
+        rgb_matrix_ws2812_dirty_end = i + 1;
+    }
 }
 
 static void setled_all(uint8_t r, uint8_t g, uint8_t b) {
@@ -0,0 +1,100 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+#include "color.h"
+}
+
+static bool rgb_equal(RGB a, RGB b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+TEST(HsvToRgbBatch, MatchesSingleConversionForAllColors) {
+    HSV hsv[256];
+    RGB rgb[256];
+    RGB rgb_nocie[256];
+
+    for (uint16_t s = 0; s < 256; s++) {
+        for (uint16_t v = 0; v < 256; v++) {
+            for (uint16_t h = 0; h < 256; h++) {
+                hsv[h] = (HSV){(uint8_t)h, (uint8_t)s, (uint8_t)v};
+            }
+            hsv_to_rgb_batch(hsv, rgb, 256);
+            hsv_to_rgb_nocie_batch(hsv, rgb_nocie, 256);
+            for (uint16_t h = 0; h < 256; h++) {
+                ASSERT_TRUE(rgb_equal(rgb[h], hsv_to_rgb(hsv[h]))) << "h=" << h << " s=" << s << " v=" << v;
+                ASSERT_TRUE(rgb_equal(rgb_nocie[h], hsv_to_rgb_nocie(hsv[h]))) << "h=" << h << " s=" << s << " v=" << v;
+            }
+        }
+    }
+}
+
+TEST(HsvToRgbBatch, EmptyBatchWritesNothing) {
+    HSV hsv    = {HSV_RED};
+    RGB rgb    = {};
+    rgb.r      = 1;
+    rgb.g      = 2;
+    rgb.b      = 3;
+    RGB before = rgb;
+
+    hsv_to_rgb_batch(&hsv, &rgb, 0);
+    EXPECT_TRUE(rgb_equal(rgb, before));
+}
+
+TEST(HsvToRgbBatch, BenchmarkPerLedAndBatch) {
+    constexpr int frames = 2000;
+
+    for (uint16_t leds : {100, 500, 1000}) {
+        std::vector<HSV> hsv(leds);
+        std::vector<RGB> rgb(leds);
+        for (uint16_t i = 0; i < leds; i++) {
+            hsv[i] = (HSV){(uint8_t)(i * 7), (uint8_t)(255 - i), (uint8_t)(i * 3)};
+        }
+
+        uint32_t checksum_single = 0, checksum_batch = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            hsv[frame % leds].h++;
+            for (uint16_t i = 0; i < leds; i++) {
+                rgb[i] = hsv_to_rgb(hsv[i]);
+            }
+            checksum_single += rgb[frame % leds].r;
+        }
+        auto single_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        for (int frame = 0; frame < frames; frame++) {
+            hsv[frame % leds].h--;
+        }
+
+        start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            hsv[frame % leds].h++;
+            hsv_to_rgb_batch(hsv.data(), rgb.data(), leds);
+            checksum_batch += rgb[frame % leds].r;
+        }
+        auto batch_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        EXPECT_EQ(checksum_single, checksum_batch);
+        std::cout << "[ BENCHMARK] " << leds << " LEDs: per-LED " << single_ns / frames << " ns/frame, batch " << batch_ns / frames << " ns/frame" << std::endl;
+    }
+}
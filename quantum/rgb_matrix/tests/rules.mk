@@ -0,0 +1,6 @@
+hsv_to_rgb_batch_DEFS := -DNO_DEBUG -DUSE_CIE1931_CURVE
+
+hsv_to_rgb_batch_SRC := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/hsv_to_rgb_batch_tests.cpp \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/led_tables.c
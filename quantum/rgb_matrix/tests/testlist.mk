@@ -0,0 +1 @@
+TEST_LIST += hsv_to_rgb_batch
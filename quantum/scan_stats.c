@@ -0,0 +1,158 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "scan_stats.h"
+#include "timer.h"
+
+// Section timing uses the ChibiOS system timer where available, the millisecond timer otherwise
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+typedef systime_t scan_stats_time_t;
+#    define scan_stats_time_read() chVTGetSystemTimeX()
+#    define scan_stats_time_elapsed_us(start) ((uint32_t)TIME_I2US(chTimeDiffX((start), chVTGetSystemTimeX())))
+#else
+typedef uint32_t scan_stats_time_t;
+#    define scan_stats_time_read() timer_read32()
+#    define scan_stats_time_elapsed_us(start) (timer_elapsed32(start) * 1000)
+#endif
+
+static scan_stats_time_t   section_start[SCAN_STATS_SECTION_COUNT];
+static scan_stats_window_t current;
+static scan_stats_window_t history[SCAN_STATS_HISTORY];
+static uint8_t             history_head  = 0;
+static uint8_t             history_count = 0;
+static uint32_t            window_timer  = 0;
+
+static void clear_window(scan_stats_window_t *window) {
+    memset(window->sections, 0, sizeof(window->sections));
+    for (uint8_t i = 0; i < SCAN_STATS_SECTION_COUNT; i++) {
+        window->sections[i].min_us = UINT16_MAX;
+    }
+}
+
+/** \brief Discards all recorded windows and starts a new one */
+void scan_stats_clear(void) {
+    history_head  = 0;
+    history_count = 0;
+    window_timer  = timer_read32();
+    clear_window(&current);
+    current.sequence = 0;
+}
+
+void scan_stats_start(scan_stats_section_t section) {
+    section_start[section] = scan_stats_time_read();
+}
+
+void scan_stats_stop(scan_stats_section_t section) {
+    uint32_t             elapsed = scan_stats_time_elapsed_us(section_start[section]);
+    uint16_t             clamped = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+    scan_stats_record_t *record  = &current.sections[section];
+
+    record->count++;
+    record->total_us += elapsed;
+    if (clamped < record->min_us) record->min_us = clamped;
+    if (clamped > record->max_us) record->max_us = clamped;
+
+    uint8_t bucket = 0;
+    while (bucket < SCAN_STATS_HISTOGRAM_BUCKETS - 1 && elapsed >= (4UL << (2 * bucket))) {
+        bucket++;
+    }
+    if (record->histogram[bucket] < UINT16_MAX) {
+        record->histogram[bucket]++;
+    }
+}
+
+/** \brief Moves the current window into the history once SCAN_STATS_WINDOW_MS have passed */
+void scan_stats_task(void) {
+    uint32_t elapsed = timer_elapsed32(window_timer);
+    if (elapsed < SCAN_STATS_WINDOW_MS) {
+        return;
+    }
+
+    current.duration_ms   = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+    history[history_head] = current;
+    history_head          = (history_head + 1) % SCAN_STATS_HISTORY;
+    if (history_count < SCAN_STATS_HISTORY) {
+        history_count++;
+    }
+
+    window_timer = timer_read32();
+    clear_window(&current);
+    current.sequence++;
+}
+
+const scan_stats_window_t *scan_stats_get_window(uint8_t age) {
+    if (age >= history_count) {
+        return NULL;
+    }
+    return &history[(history_head + SCAN_STATS_HISTORY - 1 - age) % SCAN_STATS_HISTORY];
+}
+
+static void write_u16(uint8_t *dest, uint16_t value) {
+    dest[0] = value >> 8;
+    dest[1] = value & 0xFF;
+}
+
+static void write_u32(uint8_t *dest, uint32_t value) {
+    write_u16(&dest[0], value >> 16);
+    write_u16(&dest[2], value & 0xFFFF);
+}
+
+/** \brief Raw HID protocol, all values big endian
+ *
+ * * get_info:      [id, 0x01] -> [id, 0x01, version, sections, history, buckets, window_ms:2, sequence:2, available]
+ * * get_summary:   [id, 0x02, age, section] -> [id, 0x02, age, section, sequence:2, duration_ms:2, count:4, total_us:4, min_us:2, max_us:2]
+ * * get_histogram: [id, 0x03, age, section] -> [id, 0x03, age, section, sequence:2, bucket:2 * buckets]
+ * * reset:         [id, 0x04] -> [id, 0x04]
+ *
+ * Unknown commands, as well as windows or sections that do not exist, are answered with 0xFF in the command byte.
+ */
+void scan_stats_raw_hid_receive(uint8_t *data, uint8_t length) {
+    uint8_t *command_id   = &(data[1]);
+    uint8_t *command_data = &(data[2]);
+
+    switch (*command_id) {
+        case scan_stats_get_info: {
+            const scan_stats_window_t *latest = scan_stats_get_window(0);
+            command_data[0]                   = SCAN_STATS_PROTOCOL_VERSION;
+            command_data[1]                   = SCAN_STATS_SECTION_COUNT;
+            command_data[2]                   = SCAN_STATS_HISTORY;
+            command_data[3]                   = SCAN_STATS_HISTOGRAM_BUCKETS;
+            write_u16(&command_data[4], SCAN_STATS_WINDOW_MS);
+            write_u16(&command_data[6], latest ? latest->sequence : 0);
+            command_data[8] = history_count;
+            break;
+        }
+        case scan_stats_get_summary:
+        case scan_stats_get_histogram: {
+            const scan_stats_window_t *window = scan_stats_get_window(command_data[0]);
+            if (!window || command_data[1] >= SCAN_STATS_SECTION_COUNT) {
+                *command_id = scan_stats_unhandled;
+                break;
+            }
+            const scan_stats_record_t *record = &window->sections[command_data[1]];
+            write_u16(&command_data[2], window->sequence);
+            if (*command_id == scan_stats_get_summary) {
+                write_u16(&command_data[4], window->duration_ms);
+                write_u32(&command_data[6], record->count);
+                write_u32(&command_data[10], record->total_us);
+                write_u16(&command_data[14], record->count ? record->min_us : 0);
+                write_u16(&command_data[16], record->max_us);
+            } else {
+                for (uint8_t i = 0; i < SCAN_STATS_HISTOGRAM_BUCKETS && 8 + 2 * i <= length; i++) {
+                    write_u16(&command_data[4 + 2 * i], record->histogram[i]);
+                }
+            }
+            break;
+        }
+        case scan_stats_reset: {
+            scan_stats_clear();
+            break;
+        }
+        default: {
+            *command_id = scan_stats_unhandled;
+            break;
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** \brief Length of one measurement window in milliseconds */
+#ifndef SCAN_STATS_WINDOW_MS
+#    define SCAN_STATS_WINDOW_MS 1000
+#endif
+
+/** \brief Number of completed windows kept in RAM */
+#ifndef SCAN_STATS_HISTORY
+#    if defined(__AVR__)
+#        define SCAN_STATS_HISTORY 1
+#    else
+#        define SCAN_STATS_HISTORY 4
+#    endif
+#endif
+
+/** \brief Number of histogram buckets; bucket n counts durations below 4^(n+1) microseconds, the last one everything above */
+#ifndef SCAN_STATS_HISTOGRAM_BUCKETS
+#    define SCAN_STATS_HISTOGRAM_BUCKETS 8
+#endif
+
+/** \brief First byte of raw HID reports addressed to the scan statistics */
+#ifndef SCAN_STATS_RAW_HID_ID
+#    define SCAN_STATS_RAW_HID_ID 0xF0
+#endif
+
+/** \brief Version of the raw HID protocol, bumped whenever the report layout changes */
+#define SCAN_STATS_PROTOCOL_VERSION 0x01
+
+/** \brief Parts of keyboard_task() that are timed separately */
+typedef enum {
+    SCAN_STATS_KEYBOARD_TASK,        // one whole keyboard_task() iteration
+    SCAN_STATS_MATRIX_SCAN,          // matrix_scan(), including debounce and split transport
+    SCAN_STATS_KEY_EVENTS,           // processing of the key events found by the scan
+    SCAN_STATS_QUANTUM_TASK,         // quantum_task()
+    SCAN_STATS_RGB_MATRIX_TASK,      // rgb_matrix_task()
+    SCAN_STATS_OLED_TASK,            // oled_task()
+    SCAN_STATS_POINTING_DEVICE_TASK, // pointing_device_task()
+    SCAN_STATS_SPLIT_TRANSACTIONS,   // split transport exchange on the master half
+    SCAN_STATS_SECTION_COUNT,
+} scan_stats_section_t;
+
+/** \brief Raw HID commands, sent in the second byte of the report */
+enum scan_stats_command_id {
+    scan_stats_get_info      = 0x01,
+    scan_stats_get_summary   = 0x02,
+    scan_stats_get_histogram = 0x03,
+    scan_stats_reset         = 0x04,
+    scan_stats_unhandled     = 0xFF,
+};
+
+typedef struct {
+    uint32_t count;
+    uint32_t total_us;
+    uint16_t min_us;
+    uint16_t max_us;
+    uint16_t histogram[SCAN_STATS_HISTOGRAM_BUCKETS];
+} scan_stats_record_t;
+
+typedef struct {
+    uint16_t            sequence;
+    uint16_t            duration_ms;
+    scan_stats_record_t sections[SCAN_STATS_SECTION_COUNT];
+} scan_stats_window_t;
+
+#ifdef SCAN_STATS_ENABLE
+
+void scan_stats_start(scan_stats_section_t section);
+void scan_stats_stop(scan_stats_section_t section);
+void scan_stats_task(void);
+void scan_stats_clear(void);
+
+/** \brief Returns a completed window, age 0 being the most recent one, or NULL if it does not exist yet */
+const scan_stats_window_t *scan_stats_get_window(uint8_t age);
+
+/** \brief Handles a raw HID report whose first byte is SCAN_STATS_RAW_HID_ID, writing the reply into the same buffer */
+void scan_stats_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#else
+
+#    define scan_stats_start(section)
+#    define scan_stats_stop(section)
+#    define scan_stats_task()
+
+#endif
@@ -15,10 +15,12 @@
  */
 
 #include <ctype.h>
+#include <string.h>
 
 #include "quantum.h"
 
 #include "send_string.h"
+#include "eeprom.h"
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -142,6 +144,105 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 // Note: we bit-pack in "reverse" order to optimize loading
 #define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
 
+typedef enum {
+    SEND_STRING_SOURCE_RAM,
+    SEND_STRING_SOURCE_PROGMEM,
+    SEND_STRING_SOURCE_EEPROM, // dynamic keymap macro, codes are stored without SS_QMK_PREFIX
+} send_string_source_t;
+
+// end bounds EEPROM strings, which can be rewritten while they are being sent, and reads as the terminator
+static char send_string_read(const char *str, const char *end, send_string_source_t source) {
+    switch (source) {
+        case SEND_STRING_SOURCE_PROGMEM:
+            return pgm_read_byte(str);
+        case SEND_STRING_SOURCE_EEPROM:
+            return str < end ? eeprom_read_byte((const uint8_t *)str) : 0;
+        default:
+            return *str;
+    }
+}
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+static void send_string_async_hold(uint8_t keycode);
+static void send_string_async_release(uint8_t keycode);
+#else
+#    define send_string_async_hold(keycode)
+#    define send_string_async_release(keycode)
+#endif
+
+/** \brief Sends the character or code at the start of str
+ *
+ * Returns where the next one starts, and how long SS_DELAY asked to wait in delay.
+ */
+static const char *send_string_step(const char *str, const char *end, send_string_source_t source, uint32_t *delay, bool async) {
+    char ascii_code = send_string_read(str, end, source);
+    bool is_code    = false;
+
+    if (source == SEND_STRING_SOURCE_EEPROM) {
+        is_code = ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE;
+    } else if (ascii_code == SS_QMK_PREFIX) {
+        ascii_code = send_string_read(++str, end, source);
+        is_code    = true;
+    }
+
+    if (!is_code) {
+        send_char(ascii_code);
+        return str + 1;
+    }
+
+    if (ascii_code < SS_TAP_CODE || ascii_code > SS_DELAY_CODE) {
+        // unknown, skip it unless the string ended
+        return ascii_code ? str + 1 : str;
+    }
+
+    uint8_t keycode = send_string_read(++str, end, source);
+    if (!keycode) {
+        // truncated, stop at the terminator
+        return str;
+    }
+
+    if (ascii_code == SS_TAP_CODE) {
+        // tap
+        tap_code(keycode);
+    } else if (ascii_code == SS_DOWN_CODE) {
+        // down
+        register_code(keycode);
+        if (async) {
+            send_string_async_hold(keycode);
+        }
+    } else if (ascii_code == SS_UP_CODE) {
+        // up
+        unregister_code(keycode);
+        if (async) {
+            send_string_async_release(keycode);
+        }
+    } else if (ascii_code == SS_DELAY_CODE) {
+        // delay
+        uint32_t ms = 0;
+        while (isdigit(keycode)) {
+            ms *= 10;
+            ms += keycode - '0';
+            keycode = send_string_read(++str, end, source);
+        }
+        *delay = ms;
+        if (!keycode) {
+            return str;
+        }
+    }
+    return str + 1;
+}
+
+static void send_string_with_delay_from(const char *str, const char *end, uint8_t interval, send_string_source_t source) {
+    while (send_string_read(str, end, source)) {
+        uint32_t ms = 0;
+        str         = send_string_step(str, end, source, &ms, false);
+        // interval
+        ms += interval;
+        while (ms--)
+            wait_ms(1);
+    }
+}
+
 void send_string(const char *str) {
     send_string_with_delay(str, 0);
 }
@@ -151,90 +252,136 @@ void send_string_P(const char *str) {
 }
 
 void send_string_with_delay(const char *str, uint8_t interval) {
-    while (1) {
-        char ascii_code = *str;
-        if (!ascii_code) break;
-        if (ascii_code == SS_QMK_PREFIX) {
-            ascii_code = *(++str);
-            if (ascii_code == SS_TAP_CODE) {
-                // tap
-                uint8_t keycode = *(++str);
-                tap_code(keycode);
-            } else if (ascii_code == SS_DOWN_CODE) {
-                // down
-                uint8_t keycode = *(++str);
-                register_code(keycode);
-            } else if (ascii_code == SS_UP_CODE) {
-                // up
-                uint8_t keycode = *(++str);
-                unregister_code(keycode);
-            } else if (ascii_code == SS_DELAY_CODE) {
-                // delay
-                int     ms      = 0;
-                uint8_t keycode = *(++str);
-                while (isdigit(keycode)) {
-                    ms *= 10;
-                    ms += keycode - '0';
-                    keycode = *(++str);
-                }
-                while (ms--)
-                    wait_ms(1);
-            }
-        } else {
-            send_char(ascii_code);
+    send_string_with_delay_from(str, NULL, interval, SEND_STRING_SOURCE_RAM);
+}
+
+void send_string_with_delay_P(const char *str, uint8_t interval) {
+    send_string_with_delay_from(str, NULL, interval, SEND_STRING_SOURCE_PROGMEM);
+}
+
+void send_string_eeprom_macro(const void *addr, const void *end) {
+    send_string_with_delay_from((const char *)addr, (const char *)end, 0, SEND_STRING_SOURCE_EEPROM);
+}
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+typedef struct {
+    const char *                 str;
+    const char *                 end; // EEPROM strings only
+    send_string_async_callback_t callback;
+    send_string_source_t         source;
+    uint8_t                      interval;
+} send_string_job_t;
+
+static send_string_job_t send_string_jobs[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t           send_string_jobs_head  = 0;
+static uint8_t           send_string_jobs_count = 0;
+static uint32_t          send_string_wait_start;
+static uint32_t          send_string_wait = 0;
+// keys pressed with SS_DOWN by the current string, released if it is cancelled
+static uint8_t send_string_held[SEND_STRING_ASYNC_HELD_KEYS];
+
+static void send_string_async_hold(uint8_t keycode) {
+    for (uint8_t i = 0; i < SEND_STRING_ASYNC_HELD_KEYS; i++) {
+        if (!send_string_held[i] || send_string_held[i] == keycode) {
+            send_string_held[i] = keycode;
+            return;
         }
-        ++str;
-        // interval
-        {
-            uint8_t ms = interval;
-            while (ms--)
-                wait_ms(1);
+    }
+}
+
+static void send_string_async_release(uint8_t keycode) {
+    for (uint8_t i = 0; i < SEND_STRING_ASYNC_HELD_KEYS; i++) {
+        if (send_string_held[i] == keycode) {
+            send_string_held[i] = KC_NO;
         }
     }
 }
 
-void send_string_with_delay_P(const char *str, uint8_t interval) {
-    while (1) {
-        char ascii_code = pgm_read_byte(str);
-        if (!ascii_code) break;
-        if (ascii_code == SS_QMK_PREFIX) {
-            ascii_code = pgm_read_byte(++str);
-            if (ascii_code == SS_TAP_CODE) {
-                // tap
-                uint8_t keycode = pgm_read_byte(++str);
-                tap_code(keycode);
-            } else if (ascii_code == SS_DOWN_CODE) {
-                // down
-                uint8_t keycode = pgm_read_byte(++str);
-                register_code(keycode);
-            } else if (ascii_code == SS_UP_CODE) {
-                // up
-                uint8_t keycode = pgm_read_byte(++str);
-                unregister_code(keycode);
-            } else if (ascii_code == SS_DELAY_CODE) {
-                // delay
-                int     ms      = 0;
-                uint8_t keycode = pgm_read_byte(++str);
-                while (isdigit(keycode)) {
-                    ms *= 10;
-                    ms += keycode - '0';
-                    keycode = pgm_read_byte(++str);
-                }
-                while (ms--)
-                    wait_ms(1);
-            }
-        } else {
-            send_char(ascii_code);
+static bool send_string_async_enqueue(const char *str, const char *end, uint8_t interval, send_string_source_t source, send_string_async_callback_t callback) {
+    if (send_string_jobs_count == SEND_STRING_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+    uint8_t index           = (send_string_jobs_head + send_string_jobs_count) % SEND_STRING_ASYNC_QUEUE_SIZE;
+    send_string_jobs[index] = (send_string_job_t){.str = str, .end = end, .callback = callback, .source = source, .interval = interval};
+    send_string_jobs_count++;
+    return true;
+}
+
+/** \brief Removes the string being sent and tells its owner whether it was sent in full */
+static void send_string_async_finish(bool completed) {
+    send_string_async_callback_t callback = send_string_jobs[send_string_jobs_head].callback;
+
+    send_string_jobs_head = (send_string_jobs_head + 1) % SEND_STRING_ASYNC_QUEUE_SIZE;
+    send_string_jobs_count--;
+    send_string_wait = 0;
+    memset(send_string_held, 0, sizeof(send_string_held));
+
+    if (callback) {
+        callback(completed);
+    }
+}
+
+bool send_string_async(const char *str, send_string_async_callback_t callback) {
+    return send_string_async_enqueue(str, NULL, 0, SEND_STRING_SOURCE_RAM, callback);
+}
+
+bool send_string_async_P(const char *str, send_string_async_callback_t callback) {
+    return send_string_async_enqueue(str, NULL, 0, SEND_STRING_SOURCE_PROGMEM, callback);
+}
+
+bool send_string_with_delay_async(const char *str, uint8_t interval, send_string_async_callback_t callback) {
+    return send_string_async_enqueue(str, NULL, interval, SEND_STRING_SOURCE_RAM, callback);
+}
+
+bool send_string_with_delay_async_P(const char *str, uint8_t interval, send_string_async_callback_t callback) {
+    return send_string_async_enqueue(str, NULL, interval, SEND_STRING_SOURCE_PROGMEM, callback);
+}
+
+bool send_string_async_eeprom_macro(const void *addr, const void *end, send_string_async_callback_t callback) {
+    return send_string_async_enqueue((const char *)addr, (const char *)end, 0, SEND_STRING_SOURCE_EEPROM, callback);
+}
+
+bool send_string_async_is_busy(void) {
+    return send_string_jobs_count > 0;
+}
+
+void send_string_async_cancel(void) {
+    // only the string being sent can have pressed anything
+    for (uint8_t i = 0; i < SEND_STRING_ASYNC_HELD_KEYS; i++) {
+        if (send_string_held[i]) {
+            unregister_code(send_string_held[i]);
         }
-        ++str;
+    }
+    while (send_string_jobs_count) {
+        send_string_async_finish(false);
+    }
+}
+
+void send_string_task(void) {
+    for (uint8_t sent = 0; send_string_jobs_count && sent < SEND_STRING_ASYNC_CHARS_PER_TASK;) {
+        if (send_string_wait && timer_elapsed32(send_string_wait_start) < send_string_wait) {
+            return;
+        }
+        send_string_wait = 0;
+
+        send_string_job_t *job = &send_string_jobs[send_string_jobs_head];
+        if (!send_string_read(job->str, job->end, job->source)) {
+            send_string_async_finish(true);
+            continue;
+        }
+
+        uint32_t ms = 0;
+        job->str    = send_string_step(job->str, job->end, job->source, &ms, true);
+        sent++;
         // interval
-        {
-            uint8_t ms = interval;
-            while (ms--)
-                wait_ms(1);
+        ms += job->interval;
+        if (ms) {
+            send_string_wait_start = timer_read32();
+            send_string_wait       = ms;
         }
     }
 }
+#endif
 
 void send_char(char ascii_code) {
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
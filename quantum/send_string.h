@@ -15,6 +15,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -45,6 +46,41 @@ void send_string_with_delay(const char *str, uint8_t interval);
 void send_string_P(const char *str);
 void send_string_with_delay_P(const char *str, uint8_t interval);
 void send_char(char ascii_code);
+/** \brief Sends a dynamic keymap macro stored at addr in EEPROM, reading no further than end */
+void send_string_eeprom_macro(const void *addr, const void *end);
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+#        define SEND_STRING_ASYNC_QUEUE_SIZE 4
+#    endif
+#    ifndef SEND_STRING_ASYNC_CHARS_PER_TASK
+#        define SEND_STRING_ASYNC_CHARS_PER_TASK 1
+#    endif
+#    ifndef SEND_STRING_ASYNC_HELD_KEYS
+#        define SEND_STRING_ASYNC_HELD_KEYS 4
+#    endif
+
+#    define SEND_STRING_ASYNC(string, callback) send_string_async_P(PSTR(string), callback)
+
+/** \brief Called once a string queued with send_string_async() is done, completed is false if it was cancelled */
+typedef void (*send_string_async_callback_t)(bool completed);
+
+/** \brief Queues a string to be typed from keyboard_task(), the string must stay valid until the callback
+ *
+ * Returns false if SEND_STRING_ASYNC_QUEUE_SIZE strings are already waiting.
+ */
+bool send_string_async(const char *str, send_string_async_callback_t callback);
+bool send_string_async_P(const char *str, send_string_async_callback_t callback);
+bool send_string_with_delay_async(const char *str, uint8_t interval, send_string_async_callback_t callback);
+bool send_string_with_delay_async_P(const char *str, uint8_t interval, send_string_async_callback_t callback);
+/** \brief Queues a dynamic keymap macro stored at addr in EEPROM, which is read no further than end while it is typed */
+bool send_string_async_eeprom_macro(const void *addr, const void *end, send_string_async_callback_t callback);
+
+bool send_string_async_is_busy(void);
+/** \brief Stops the string being sent, drops all queued ones and releases keys they held down */
+void send_string_async_cancel(void);
+void send_string_task(void);
+#endif
 
 void send_dword(uint32_t number);
 void send_word(uint16_t number);
@@ -22,6 +22,7 @@
 #include "quantum.h"
 #include "wait.h"
 #include "usb_util.h"
+#include "scan_stats.h"
 
 #ifdef EE_HANDS
 #    include "eeconfig.h"
@@ -175,7 +176,9 @@ bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t sl
     }
 #endif // SPLIT_MAX_CONNECTION_ERRORS > 0 && SPLIT_CONNECTION_CHECK_TIMEOUT > 0
 
+    scan_stats_start(SCAN_STATS_SPLIT_TRANSACTIONS);
     __attribute__((unused)) bool okay = transport_master(master_matrix, slave_matrix);
+    scan_stats_stop(SCAN_STATS_SPLIT_TRANSACTIONS);
 #if SPLIT_MAX_CONNECTION_ERRORS > 0
     if (!okay) {
         if (connection_errors < UINT8_MAX) {
@@ -14,3 +14,8 @@ void split_post_init(void);
 
 bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 bool is_transport_connected(void);
+
+#if defined(SERIAL_USART_PUSH) && !defined(DISABLE_SYNC_TIMER)
+// time the slave scanned the matrix it last pushed, or now if that is unknown or stale
+uint16_t split_slave_matrix_scan_time(uint16_t now);
+#endif
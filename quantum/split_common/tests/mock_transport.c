@@ -0,0 +1,154 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "mock_transport.h"
+#include "transaction_id_define.h"
+
+static split_shared_memory_t master_memory;
+static split_shared_memory_t slave_memory;
+split_shared_memory_t *const split_shmem = &master_memory;
+
+matrix_row_t mock_slave_matrix[MATRIX_ROWS / 2];
+matrix_row_t mock_slave_mirror[MATRIX_ROWS / 2];
+
+uint8_t mock_transport_latency   = 0;
+bool    mock_transport_fail_next = false;
+
+mock_transaction_t mock_transport_log[MOCK_TRANSPORT_LOG_SIZE];
+uint8_t            mock_transport_log_count = 0;
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+static transport_status_t status = TRANSPORT_IDLE;
+static uint8_t            polls_left;
+static int8_t             started_id;
+#endif // SPLIT_TRANSPORT_ASYNC
+static uint8_t reply[UINT8_MAX];
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+void mock_transport_reset(void) {
+    memset(mock_slave_matrix, 0, sizeof(mock_slave_matrix));
+    memset(mock_slave_mirror, 0, sizeof(mock_slave_mirror));
+    mock_transport_latency   = 0;
+    mock_transport_fail_next = false;
+    mock_transport_log_count = 0;
+#ifdef SPLIT_TRANSPORT_ASYNC
+    status = TRANSPORT_IDLE;
+#endif // SPLIT_TRANSPORT_ASYNC
+
+    // Start out with both halves in sync, as the transaction layer keeps its own state between tests
+    memset(&master_memory, 0, sizeof(master_memory));
+    transactions_slave(mock_slave_mirror, mock_slave_matrix);
+    slave_memory = master_memory;
+}
+
+static uint32_t packed_ids(const split_sync_frame_m2s_t *frame) {
+    uint32_t packed = 0;
+    for (uint8_t pos = 0; pos < frame->length;) {
+        uint8_t id = frame->payload[pos++];
+        packed |= (1UL << id);
+        pos += split_transaction_table[id].initiator2target_buffer_size;
+    }
+    return packed;
+}
+
+static bool log_transaction(int8_t id) {
+    mock_transaction_t *entry = &mock_transport_log[mock_transport_log_count % MOCK_TRANSPORT_LOG_SIZE];
+    mock_transport_log_count++;
+
+    entry->id       = id;
+    entry->packed   = id == SYNC_FRAME ? packed_ids(&master_memory.sync_frame_m2s) : 0;
+    entry->failed   = mock_transport_fail_next;
+    mock_transport_fail_next = false;
+    return !entry->failed;
+}
+
+/* Runs the slave half on its own memory: receive the request, run the
+ * callback, scan, and keep the reply until the master collects it. */
+static void slave_exchange(int8_t id) {
+    split_transaction_desc_t *trans  = &split_transaction_table[id];
+    split_shared_memory_t     master = master_memory;
+
+    master_memory = slave_memory;
+    memcpy(split_trans_initiator2target_buffer(trans), ((uint8_t *)&master) + trans->initiator2target_offset, trans->initiator2target_buffer_size);
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+    transactions_slave(mock_slave_mirror, mock_slave_matrix);
+    memcpy(reply, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+
+    slave_memory  = master_memory;
+    master_memory = master;
+}
+
+static void deliver_reply(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    memcpy(split_trans_target2initiator_buffer(trans), reply, trans->target2initiator_buffer_size);
+}
+
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length);
+    }
+    if (!log_transaction(id)) {
+        return false;
+    }
+    slave_exchange(id);
+    deliver_reply(id);
+    if (target2initiator_length > 0) {
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length);
+    }
+    return true;
+}
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+bool transport_begin_transaction(int8_t id) {
+    if (status != TRANSPORT_IDLE) {
+        return false;
+    }
+    // The request goes out right away, the reply only shows up once polled as complete
+    if (log_transaction(id)) {
+        slave_exchange(id);
+        status = TRANSPORT_SUCCESS;
+    } else {
+        status = TRANSPORT_FAILED;
+    }
+    started_id = id;
+    polls_left = mock_transport_latency;
+    return true;
+}
+
+transport_status_t transport_poll_transaction(void) {
+    if (status == TRANSPORT_IDLE) {
+        return TRANSPORT_IDLE;
+    }
+    if (polls_left > 0) {
+        polls_left--;
+        return TRANSPORT_PENDING;
+    }
+    transport_status_t result = status;
+    if (result == TRANSPORT_SUCCESS) {
+        deliver_reply(started_id);
+    }
+    status = TRANSPORT_IDLE;
+    return result;
+}
+#endif // SPLIT_TRANSPORT_ASYNC
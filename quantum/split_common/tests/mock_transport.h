@@ -0,0 +1,43 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "transactions.h"
+
+#define MOCK_TRANSPORT_LOG_SIZE 16
+
+typedef struct {
+    int8_t   id;
+    uint32_t packed; // transactions carried by a sync frame
+    bool     failed;
+} mock_transaction_t;
+
+/* Loopback transport: transactions run the slave side of the transaction layer
+ * on a separate copy of the shared memory, with the matrices below. */
+extern matrix_row_t mock_slave_matrix[MATRIX_ROWS / 2]; // matrix of the slave half
+extern matrix_row_t mock_slave_mirror[MATRIX_ROWS / 2]; // master matrix as received by the slave half
+
+extern uint8_t mock_transport_latency;   // number of polls that report a started transaction as pending
+extern bool    mock_transport_fail_next; // makes the next transaction fail without reaching the slave
+
+extern mock_transaction_t mock_transport_log[MOCK_TRANSPORT_LOG_SIZE];
+extern uint8_t            mock_transport_log_count;
+
+void mock_transport_reset(void);
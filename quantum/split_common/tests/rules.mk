@@ -0,0 +1,26 @@
+split_transport_async_DEFS := \
+	-DMATRIX_ROWS=4 -DMATRIX_COLS=8 -DNO_DEBUG -DIGNORE_ATOMIC_BLOCK \
+	-DSPLIT_KEYBOARD -DSPLIT_TRANSPORT_MIRROR -DDISABLE_SYNC_TIMER \
+	-DSPLIT_TRANSPORT_SYNC_FRAME -DSPLIT_TRANSPORT_ASYNC
+
+split_transport_async_INC := $(QUANTUM_PATH)/split_common
+
+split_transport_async_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/mock_transport.c \
+	$(QUANTUM_PATH)/split_common/tests/split_transport_async_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+split_transport_sync_frame_DEFS := \
+	-DMATRIX_ROWS=4 -DMATRIX_COLS=8 -DNO_DEBUG -DIGNORE_ATOMIC_BLOCK \
+	-DSPLIT_KEYBOARD -DSPLIT_TRANSPORT_SYNC_FRAME
+
+split_transport_sync_frame_INC := $(QUANTUM_PATH)/split_common
+
+split_transport_sync_frame_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/mock_transport.c \
+	$(QUANTUM_PATH)/split_common/tests/split_transport_sync_frame_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
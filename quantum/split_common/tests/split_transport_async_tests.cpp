@@ -0,0 +1,111 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+// The split headers use the C11 spelling
+#define _Static_assert static_assert
+
+extern "C" {
+#include "transactions.h"
+#include "transaction_id_define.h"
+#include "mock_transport.h"
+}
+
+class SplitTransportAsync : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_transport_reset();
+        memset(master_matrix, 0, sizeof(master_matrix));
+        memset(slave_matrix, 0, sizeof(slave_matrix));
+    }
+
+    bool scan(void) {
+        return transactions_master(master_matrix, slave_matrix);
+    }
+
+    matrix_row_t master_matrix[MATRIX_ROWS / 2];
+    matrix_row_t slave_matrix[MATRIX_ROWS / 2];
+};
+
+TEST_F(SplitTransportAsync, SlaveMatrixIsConsumedOnTheNextScan) {
+    mock_slave_matrix[0] = 0x3;
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(mock_transport_log_count, 1);
+    EXPECT_EQ(slave_matrix[0], 0);
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(mock_transport_log_count, 2);
+    EXPECT_EQ(slave_matrix[0], 0x3);
+}
+
+TEST_F(SplitTransportAsync, OnlyOneFrameIsInFlight) {
+    mock_transport_latency = 2;
+    mock_slave_matrix[1]   = 0x5;
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(mock_transport_log_count, 1);
+
+    // The master keeps scanning while the frame is pending
+    for (int i = 0; i < 2; i++) {
+        EXPECT_TRUE(scan());
+        EXPECT_EQ(mock_transport_log_count, 1);
+        EXPECT_NE(slave_matrix[1], 0x5);
+    }
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(mock_transport_log_count, 2);
+    EXPECT_EQ(slave_matrix[1], 0x5);
+}
+
+TEST_F(SplitTransportAsync, StagedDataIsSentWithTheNextFrame) {
+    EXPECT_TRUE(scan());
+    master_matrix[0] = 0x9;
+    EXPECT_TRUE(scan());
+
+    ASSERT_EQ(mock_transport_log_count, 2);
+    EXPECT_EQ(mock_transport_log[1].id, SYNC_FRAME);
+    EXPECT_TRUE(mock_transport_log[1].packed & (1UL << PUT_MASTER_MATRIX));
+    EXPECT_EQ(mock_slave_mirror[0], 0x9);
+
+    // Nothing changed, so the following frame only reads
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(mock_transport_log[2].id, SYNC_FRAME_READ);
+}
+
+TEST_F(SplitTransportAsync, FailedFrameIsSentAgain) {
+    EXPECT_TRUE(scan());
+    master_matrix[0]         = 0x9;
+    mock_transport_fail_next = true;
+
+    EXPECT_TRUE(scan());
+    ASSERT_EQ(mock_transport_log_count, 2);
+    EXPECT_EQ(mock_transport_log[1].id, SYNC_FRAME);
+    EXPECT_TRUE(mock_transport_log[1].failed);
+
+    // The failure is reported on the next scan, which does not start another frame
+    EXPECT_FALSE(scan());
+    EXPECT_EQ(mock_transport_log_count, 2);
+    EXPECT_EQ(mock_slave_mirror[0], 0);
+
+    EXPECT_TRUE(scan());
+    ASSERT_EQ(mock_transport_log_count, 3);
+    EXPECT_EQ(mock_transport_log[2].id, SYNC_FRAME);
+    EXPECT_TRUE(mock_transport_log[2].packed & (1UL << PUT_MASTER_MATRIX));
+    EXPECT_FALSE(mock_transport_log[2].failed);
+    EXPECT_EQ(mock_slave_mirror[0], 0x9);
+}
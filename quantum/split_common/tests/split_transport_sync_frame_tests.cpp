@@ -0,0 +1,74 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+// The split headers use the C11 spelling
+#define _Static_assert static_assert
+
+extern "C" {
+#include "transactions.h"
+#include "transaction_id_define.h"
+#include "mock_transport.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+// Both halves share one clock here, so keep what the slave was told separately
+static uint32_t slave_sync_timer = 0;
+
+uint32_t sync_timer_read32(void) {
+    return timer_read32();
+}
+
+void sync_timer_update(uint32_t time) {
+    slave_sync_timer = time;
+}
+}
+
+class SplitTransportSyncFrame : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_transport_reset();
+        memset(master_matrix, 0, sizeof(master_matrix));
+        memset(slave_matrix, 0, sizeof(slave_matrix));
+        set_time(0);
+        slave_sync_timer = 0;
+    }
+
+    bool scan(void) {
+        return transactions_master(master_matrix, slave_matrix);
+    }
+
+    matrix_row_t master_matrix[MATRIX_ROWS / 2];
+    matrix_row_t slave_matrix[MATRIX_ROWS / 2];
+};
+
+TEST_F(SplitTransportSyncFrame, SyncTimerIsReadWhenTheFrameIsPacked) {
+    // The timer is due on the first scan, and staged after that scan's frame went out
+    set_time(1000);
+    EXPECT_TRUE(scan());
+    ASSERT_EQ(mock_transport_log_count, 1);
+    EXPECT_EQ(mock_transport_log[0].id, SYNC_FRAME_READ);
+
+    advance_time(30);
+    EXPECT_TRUE(scan());
+    ASSERT_EQ(mock_transport_log_count, 2);
+    EXPECT_EQ(mock_transport_log[1].id, SYNC_FRAME);
+    EXPECT_TRUE(mock_transport_log[1].packed & (1UL << PUT_SYNC_TIMER));
+    EXPECT_EQ(slave_sync_timer, timer_read32() + 2);
+}
@@ -0,0 +1 @@
+TEST_LIST += split_transport_async split_transport_sync_frame
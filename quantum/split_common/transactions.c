@@ -45,6 +45,17 @@
 #define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 
+#ifdef SPLIT_TRANSPORT_SYNC_FRAME
+// Sync data is staged for, and served from, the single sync frame exchanged each scan
+static bool sync_frame_stage(int8_t id, const void *data, uint16_t length);
+static bool sync_frame_fetch(int8_t id, void *data, uint16_t length);
+#    define transport_sync_write(id, data, length) sync_frame_stage(id, data, length)
+#    define transport_sync_read(id, data, length) sync_frame_fetch(id, data, length)
+#else
+#    define transport_sync_write(id, data, length) transport_write(id, data, length)
+#    define transport_sync_read(id, data, length) transport_read(id, data, length)
+#endif // SPLIT_TRANSPORT_SYNC_FRAME
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
@@ -86,9 +97,9 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
 
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
-    bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
+    bool    okay = transport_sync_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
-        okay &= transport_read(trans_id_retrieve, destination, length);
+        okay &= transport_sync_read(trans_id_retrieve, destination, length);
         okay &= curr_checksum == crc8(equiv_shmem, length);
         if (okay) {
             *last_update = timer_read32();
@@ -102,7 +113,7 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
     bool okay = true;
     if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
-        okay &= transport_write(trans_id, source, length);
+        okay &= transport_sync_write(trans_id, source, length);
         if (okay) {
             *last_update = timer_read32();
         }
@@ -118,6 +129,8 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifndef SERIAL_USART_PUSH
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -138,12 +151,88 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
 }
 
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_PUSH_REGISTRATIONS
+
+#else // SERIAL_USART_PUSH
+
+// The slave pushes its matrix as soon as it changes, the master only reads it as a keepalive
+
+static uint16_t slave_scan_time           = 0;
+static bool     slave_matrix_push_pending = false;
+
+#    define slave_matrix_push_checksum(push) crc8((push), offsetof(split_slave_matrix_push_t, checksum))
+
+#    ifndef DISABLE_SYNC_TIMER
+uint16_t split_slave_matrix_scan_time(uint16_t now) {
+    // Anything older than a keepalive interval, or ahead of our own clock, is not trustworthy
+    return TIMER_DIFF_16(now, slave_scan_time) <= FORCED_SYNC_THROTTLE_MS ? slave_scan_time : now;
+}
+#    endif // DISABLE_SYNC_TIMER
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t           last_update                    = 0;
+    static matrix_row_t       last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-received matrix, so we can replicate if there are checksum errors
+    split_slave_matrix_push_t received;
+
+    bool okay = true;
+    bool got  = transport_pushed(GET_SLAVE_MATRIX_PUSH);
+    if (got) {
+        memcpy(&received, &split_shmem->smatrix_push, sizeof(received));
+    } else if (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
+        // Keepalive, which also picks up changes whose push got lost
+        okay = got = transport_read(GET_SLAVE_MATRIX_PUSH, &received, sizeof(received));
+    }
+
+    if (got) {
+        okay = received.checksum == slave_matrix_push_checksum(&received);
+        if (okay) {
+            memcpy(last_matrix, received.matrix, sizeof(last_matrix));
+            slave_scan_time = received.scan_time;
+            last_update     = timer_read32();
+        } else {
+            // Read the matrix explicitly on the retry
+            last_update = timer_read32() - FORCED_SYNC_THROTTLE_MS;
+        }
+    }
+
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_slave_matrix_push_t *push = &split_shmem->smatrix_push;
+    if (memcmp(push->matrix, slave_matrix, sizeof(push->matrix)) != 0) {
+        memcpy(push->matrix, slave_matrix, sizeof(push->matrix));
+        push->scan_time           = sync_timer_read();
+        slave_matrix_push_pending = true;
+    }
+    push->checksum = slave_matrix_push_checksum(push);
+}
+
+// Pushing blocks on the USART, so it happens outside of the atomic block of the handler
+static void slave_matrix_push_send(void) {
+    // On failure, try again on the next scan; the master also catches up through its keepalive reads
+    if (slave_matrix_push_pending && transport_push(GET_SLAVE_MATRIX_PUSH)) {
+        slave_matrix_push_pending = false;
+    }
+}
+
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE()         \
+        do {                                         \
+            TRANSACTION_HANDLER_SLAVE(slave_matrix); \
+            slave_matrix_push_send();                \
+        } while (0)
+#    define TRANSACTIONS_SLAVE_MATRIX_PUSH_REGISTRATIONS [GET_SLAVE_MATRIX_PUSH] = trans_target2initiator_initializer(smatrix_push),
+
+#endif // SERIAL_USART_PUSH
+
 // clang-format off
 #define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
-    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix), \
+    TRANSACTIONS_SLAVE_MATRIX_PUSH_REGISTRATIONS
 // clang-format on
 
 ////////////////////////////////////////////////////
@@ -223,7 +312,7 @@ static bool sync_timer_handlers_master(matrix_row_t master_matrix[], matrix_row_
     bool okay = true;
     if (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
         uint32_t sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
-        okay &= transport_write(PUT_SYNC_TIMER, &sync_timer, sizeof(sync_timer));
+        okay &= transport_sync_write(PUT_SYNC_TIMER, &sync_timer, sizeof(sync_timer));
         if (okay) {
             last_update = timer_read32();
         }
@@ -344,7 +433,7 @@ static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slav
 
     bool okay = true;
     if (mods_need_sync) {
-        okay &= transport_write(PUT_MODS, &new_mods, sizeof(new_mods));
+        okay &= transport_sync_write(PUT_MODS, &new_mods, sizeof(new_mods));
         if (okay) {
             last_update = timer_read32();
         }
@@ -610,7 +699,7 @@ static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t
     temp_cpi = pointing_device_get_shared_cpi();
     if (temp_cpi && memcmp(&last_cpi, &temp_cpi, sizeof(temp_cpi)) != 0) {
         memcpy(&split_shmem->pointing.cpi, &temp_cpi, sizeof(temp_cpi));
-        okay = transport_write(PUT_POINTING_CPI, &split_shmem->pointing.cpi, sizeof(split_shmem->pointing.cpi));
+        okay = transport_sync_write(PUT_POINTING_CPI, &split_shmem->pointing.cpi, sizeof(split_shmem->pointing.cpi));
         if (okay) {
             last_cpi = temp_cpi;
         }
@@ -664,6 +753,223 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
+////////////////////////////////////////////////////
+// Sync frame
+
+#ifdef SPLIT_TRANSPORT_SYNC_FRAME
+
+_Static_assert(sizeof(split_sync_frame_m2s_t) <= UINT8_MAX && sizeof(split_sync_frame_s2m_t) <= UINT8_MAX, "Sync frame too large for a single transaction");
+// Transactions are marked in 32-bit masks while they wait for a frame
+_Static_assert(SYNC_FRAME < 32, "Too many transactions for the sync frame masks");
+
+// The slave packs the data of every target2initiator transaction before SYNC_FRAME back to back
+#    define SYNC_FRAME_S2M_MATRIX_SIZE (sizeof_member(split_shared_memory_t, smatrix.checksum) + sizeof_member(split_shared_memory_t, smatrix.matrix))
+#    ifdef ENCODER_ENABLE
+#        define SYNC_FRAME_S2M_ENCODERS_SIZE (sizeof_member(split_shared_memory_t, encoders.checksum) + sizeof_member(split_shared_memory_t, encoders.state))
+#    else
+#        define SYNC_FRAME_S2M_ENCODERS_SIZE 0
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#        define SYNC_FRAME_S2M_POINTING_SIZE (sizeof_member(split_shared_memory_t, pointing.checksum) + sizeof_member(split_shared_memory_t, pointing.report))
+#    else
+#        define SYNC_FRAME_S2M_POINTING_SIZE 0
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+_Static_assert(SYNC_FRAME_S2M_MATRIX_SIZE + SYNC_FRAME_S2M_ENCODERS_SIZE + SYNC_FRAME_S2M_POINTING_SIZE <= sizeof_member(split_sync_frame_s2m_t, payload), "Slave data does not fit the sync frame");
+
+static uint32_t sync_frame_pending = 0; // transactions staged on the master, but not yet sent to the slave
+
+static bool sync_frame_stage(int8_t id, const void *data, uint16_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    // Data that can never fit into a frame still gets its own transaction
+    if (1 + trans->initiator2target_buffer_size > SPLIT_SYNC_FRAME_M2S_SIZE) {
+        return transport_write(id, data, length);
+    }
+    memcpy(split_trans_initiator2target_buffer(trans), data, trans->initiator2target_buffer_size < length ? trans->initiator2target_buffer_size : length);
+    sync_frame_pending |= (1UL << id);
+    return true;
+}
+
+static bool sync_frame_fetch(int8_t id, void *data, uint16_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    memcpy(data, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size < length ? trans->target2initiator_buffer_size : length);
+    return true;
+}
+
+// Pack everything staged so far into the frame, whatever does not fit waits for the next frame
+static uint32_t sync_frame_pack(split_sync_frame_m2s_t *request) {
+    uint32_t packed = 0;
+    request->length = 0;
+#    ifndef DISABLE_SYNC_TIMER
+    // The timer was staged during an earlier scan, so send the time of this frame instead
+    if (sync_frame_pending & (1UL << PUT_SYNC_TIMER)) {
+        split_shmem->sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
+    }
+#    endif // DISABLE_SYNC_TIMER
+    for (int8_t id = 0; id < SYNC_FRAME; id++) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (!(sync_frame_pending & (1UL << id)) || request->length + 1 + trans->initiator2target_buffer_size > sizeof(request->payload)) {
+            continue;
+        }
+        request->payload[request->length++] = id;
+        memcpy(&request->payload[request->length], split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+        request->length += trans->initiator2target_buffer_size;
+        packed |= (1UL << id);
+    }
+    request->checksum = crc8(&request->length, 1 + request->length);
+    return packed;
+}
+
+// Make the slave data available to the handlers, as if each transaction had been read separately
+static bool sync_frame_unpack(const split_sync_frame_s2m_t *reply) {
+    if (reply->checksum != crc8(reply->payload, sizeof(reply->payload))) {
+        return false;
+    }
+    const uint8_t *payload = reply->payload;
+    for (int8_t id = 0; id < SYNC_FRAME; id++) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(split_trans_target2initiator_buffer(trans), payload, trans->target2initiator_buffer_size);
+        payload += trans->target2initiator_buffer_size;
+    }
+    return true;
+}
+
+#    ifndef SPLIT_TRANSPORT_ASYNC
+
+static bool sync_frame_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_sync_frame_m2s_t request = {0};
+    split_sync_frame_s2m_t reply;
+    uint32_t               packed = sync_frame_pack(&request);
+
+    bool okay;
+    if (packed) {
+        okay = transport_execute_transaction(SYNC_FRAME, &request, sizeof(request), &reply, sizeof(reply));
+    } else {
+        okay = transport_read(SYNC_FRAME_READ, &reply, sizeof(reply));
+    }
+    if (!okay || !sync_frame_unpack(&reply)) {
+        return false;
+    }
+    sync_frame_pending &= ~packed;
+    return true;
+}
+
+#    else // SPLIT_TRANSPORT_ASYNC
+
+static bool     sync_frame_started   = false; // a frame was handed to the transport and its result was not consumed yet
+static bool     sync_frame_received  = false; // the slave data in shared memory is valid
+static uint32_t sync_frame_in_flight = 0;     // transactions packed into the started frame
+
+// Consumes the frame started during the previous scan, returns false if it failed
+static bool sync_frame_complete(void) {
+    switch (transport_poll_transaction()) {
+        case TRANSPORT_PENDING:
+            // Still on the wire, the handlers keep working with the last data received
+            return true;
+        case TRANSPORT_SUCCESS:
+            sync_frame_started = false;
+            if (!sync_frame_unpack(&split_shmem->sync_frame_s2m)) {
+                return false;
+            }
+            sync_frame_pending &= ~sync_frame_in_flight;
+            sync_frame_received = true;
+            return true;
+        case TRANSPORT_FAILED:
+            // Whatever was packed is still pending, so it goes out again with the next frame
+            sync_frame_started = false;
+            return false;
+        default:
+            // Nothing in flight
+            sync_frame_started = false;
+            return true;
+    }
+}
+
+// Sends everything staged by the handlers while the master goes on with its own scan
+static void sync_frame_begin(void) {
+    if (sync_frame_started) {
+        return;
+    }
+    sync_frame_in_flight = sync_frame_pack(&split_shmem->sync_frame_m2s);
+    sync_frame_started   = transport_begin_transaction(sync_frame_in_flight ? SYNC_FRAME : SYNC_FRAME_READ);
+}
+
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+static void sync_frame_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_sync_frame_s2m_t *reply   = &split_shmem->sync_frame_s2m;
+    uint8_t                *payload = reply->payload;
+    for (int8_t id = 0; id < SYNC_FRAME; id++) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(payload, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+        payload += trans->target2initiator_buffer_size;
+    }
+    reply->checksum = crc8(reply->payload, sizeof(reply->payload));
+}
+
+static void sync_frame_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    split_sync_frame_m2s_t *request = &split_shmem->sync_frame_m2s;
+    if (request->length == 0 || request->length > sizeof(request->payload) || request->checksum != crc8(&request->length, 1 + request->length)) {
+        return;
+    }
+
+    // Unpack into the locations the individual transactions would have written to
+    for (uint8_t pos = 0; pos < request->length;) {
+        uint8_t id = request->payload[pos++];
+        if (id >= SYNC_FRAME) {
+            break;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (trans->initiator2target_buffer_size == 0 || pos + trans->initiator2target_buffer_size > request->length) {
+            break;
+        }
+        memcpy(split_trans_initiator2target_buffer(trans), &request->payload[pos], trans->initiator2target_buffer_size);
+        pos += trans->initiator2target_buffer_size;
+    }
+
+    // Transports that run the callback before receiving the frame apply it on the next transaction instead, so make sure it is applied once
+    request->length = 0;
+}
+
+// clang-format off
+#    ifndef SPLIT_TRANSPORT_ASYNC
+#        define TRANSACTIONS_SYNC_FRAME_MASTER() TRANSACTION_HANDLER_MASTER(sync_frame)
+#        define TRANSACTIONS_SYNC_FRAME_BEGIN()
+#    else
+#        define TRANSACTIONS_SYNC_FRAME_MASTER()                                    \
+            do {                                                                    \
+                if (!sync_frame_complete()) return false;                           \
+                /* Nothing to hand to the handlers before the first frame arrived */ \
+                if (!sync_frame_received) {                                         \
+                    sync_frame_begin();                                             \
+                    return true;                                                    \
+                }                                                                   \
+            } while (0)
+#        define TRANSACTIONS_SYNC_FRAME_BEGIN() sync_frame_begin()
+#    endif // SPLIT_TRANSPORT_ASYNC
+#    define TRANSACTIONS_SYNC_FRAME_SLAVE() TRANSACTION_HANDLER_SLAVE(sync_frame)
+#    ifdef USE_I2C
+#        define TRANSACTIONS_SYNC_FRAME_READ_REGISTRATION [SYNC_FRAME_READ] = trans_target2initiator_initializer(sync_frame_s2m),
+#    else
+#        define TRANSACTIONS_SYNC_FRAME_READ_REGISTRATION [SYNC_FRAME_READ] = trans_target2initiator_initializer_cb(sync_frame_s2m, sync_frame_slave_callback),
+#    endif // USE_I2C
+#    define TRANSACTIONS_SYNC_FRAME_REGISTRATIONS \
+    [SYNC_FRAME] = { \
+        sizeof_member(split_shared_memory_t, sync_frame_m2s), offsetof(split_shared_memory_t, sync_frame_m2s), \
+        sizeof_member(split_shared_memory_t, sync_frame_s2m), offsetof(split_shared_memory_t, sync_frame_s2m), \
+        sync_frame_slave_callback \
+    }, \
+    TRANSACTIONS_SYNC_FRAME_READ_REGISTRATION
+// clang-format on
+
+#else // SPLIT_TRANSPORT_SYNC_FRAME
+
+#    define TRANSACTIONS_SYNC_FRAME_MASTER()
+#    define TRANSACTIONS_SYNC_FRAME_BEGIN()
+#    define TRANSACTIONS_SYNC_FRAME_SLAVE()
+#    define TRANSACTIONS_SYNC_FRAME_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_SYNC_FRAME
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -690,6 +996,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_OLED_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
     TRANSACTIONS_POINTING_REGISTRATIONS
+    TRANSACTIONS_SYNC_FRAME_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -701,6 +1008,8 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // With the sync frame, this exchanges all data with the slave, the handlers below then only stage and read back
+    TRANSACTIONS_SYNC_FRAME_MASTER();
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -716,6 +1025,8 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
     TRANSACTIONS_POINTING_MASTER();
+    // With the asynchronous transport, the frame goes out now and is consumed during the next scan
+    TRANSACTIONS_SYNC_FRAME_BEGIN();
     return true;
 }
 
@@ -735,6 +1046,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_OLED_SLAVE();
     TRANSACTIONS_ST7565_SLAVE();
     TRANSACTIONS_POINTING_SLAVE();
+    TRANSACTIONS_SYNC_FRAME_SLAVE();
 }
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
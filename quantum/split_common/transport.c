@@ -119,6 +119,30 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_TRANSPORT_ASYNC
+bool transport_begin_transaction(int8_t id) {
+    return soft_serial_transaction_begin(id);
+}
+
+transport_status_t transport_poll_transaction(void) {
+    return soft_serial_transaction_poll();
+}
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+#    ifdef SERIAL_USART_PUSH
+bool transport_push(int8_t id) {
+    return soft_serial_target_push(id);
+}
+
+bool transport_pushed(int8_t id) {
+    static uint32_t pushed = 0;
+    pushed |= soft_serial_initiator_pushed();
+    bool received = pushed & (1UL << id);
+    pushed &= ~(1UL << id);
+    return received;
+}
+#    endif // SERIAL_USART_PUSH
+
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -40,6 +40,33 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+#    if defined(USE_I2C) || !defined(SPLIT_TRANSPORT_SYNC_FRAME)
+#        error "SPLIT_TRANSPORT_ASYNC requires the serial transport and SPLIT_TRANSPORT_SYNC_FRAME"
+#    endif
+typedef enum {
+    TRANSPORT_IDLE,    // nothing started, or the result was already polled
+    TRANSPORT_PENDING, // still exchanging data with the slave
+    TRANSPORT_SUCCESS,
+    TRANSPORT_FAILED,
+} transport_status_t;
+
+// starts a transaction on the buffers in split_shmem and returns without waiting for it, false if one is still pending
+bool transport_begin_transaction(int8_t id);
+// returns the state of the transaction started last, success or failure is reported once
+transport_status_t transport_poll_transaction(void);
+#endif // SPLIT_TRANSPORT_ASYNC
+
+#ifdef SERIAL_USART_PUSH
+#    if defined(USE_I2C) || defined(SPLIT_TRANSPORT_SYNC_FRAME)
+#        error "SERIAL_USART_PUSH requires the serial transport and cannot be combined with SPLIT_TRANSPORT_SYNC_FRAME"
+#    endif
+// slave sends the target2initiator buffer of a transaction without being asked
+bool transport_push(int8_t id);
+// master returns whether the slave pushed the target2initiator buffer of a transaction since the last call
+bool transport_pushed(int8_t id);
+#endif // SERIAL_USART_PUSH
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #    define NUMBER_OF_ENCODERS (sizeof((pin_t[])ENCODERS_PAD_A) / sizeof(pin_t))
@@ -58,6 +85,14 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SERIAL_USART_PUSH
+typedef struct _split_slave_matrix_push_t {
+    matrix_row_t matrix[(MATRIX_ROWS) / 2];
+    uint16_t     scan_time; // sync timer value of the scan that last changed the matrix
+    uint8_t      checksum;
+} split_slave_matrix_push_t;
+#endif // SERIAL_USART_PUSH
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -123,6 +158,39 @@ typedef struct _rpc_sync_info_t {
 } rpc_sync_info_t;
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#ifdef SPLIT_TRANSPORT_SYNC_FRAME
+#    ifndef SPLIT_SYNC_FRAME_M2S_SIZE
+#        define SPLIT_SYNC_FRAME_M2S_SIZE 24
+#    endif // SPLIT_SYNC_FRAME_M2S_SIZE
+
+#    ifdef ENCODER_ENABLE
+#        define SPLIT_SYNC_FRAME_S2M_ENCODERS_SIZE sizeof(split_slave_encoder_sync_t)
+#    else
+#        define SPLIT_SYNC_FRAME_S2M_ENCODERS_SIZE 0
+#    endif // ENCODER_ENABLE
+
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#        define SPLIT_SYNC_FRAME_S2M_POINTING_SIZE (sizeof(uint8_t) + sizeof(report_mouse_t))
+#    else
+#        define SPLIT_SYNC_FRAME_S2M_POINTING_SIZE 0
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+
+#    define SPLIT_SYNC_FRAME_S2M_SIZE (sizeof(split_slave_matrix_sync_t) + SPLIT_SYNC_FRAME_S2M_ENCODERS_SIZE + SPLIT_SYNC_FRAME_S2M_POINTING_SIZE)
+
+// Master to slave: the data of every changed transaction, each prefixed with its transaction ID
+typedef struct _split_sync_frame_m2s_t {
+    uint8_t checksum;
+    uint8_t length;
+    uint8_t payload[SPLIT_SYNC_FRAME_M2S_SIZE];
+} split_sync_frame_m2s_t;
+
+// Slave to master: the data of all slave-side transactions, in transaction ID order
+typedef struct _split_sync_frame_s2m_t {
+    uint8_t checksum;
+    uint8_t payload[SPLIT_SYNC_FRAME_S2M_SIZE];
+} split_sync_frame_s2m_t;
+#endif // SPLIT_TRANSPORT_SYNC_FRAME
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -130,6 +198,10 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SERIAL_USART_PUSH
+    split_slave_matrix_push_t smatrix_push;
+#endif // SERIAL_USART_PUSH
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -186,6 +258,11 @@ typedef struct _split_shared_memory_t {
     split_slave_pointing_sync_t pointing;
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
+#ifdef SPLIT_TRANSPORT_SYNC_FRAME
+    split_sync_frame_m2s_t sync_frame_m2s;
+    split_sync_frame_s2m_t sync_frame_s2m;
+#endif // SPLIT_TRANSPORT_SYNC_FRAME
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
@@ -0,0 +1,92 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "eeprom.h"
+#include "timer.h"
+#include "dynamic_keymap.h"
+
+void advance_time(uint32_t ms);
+
+extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    {{0x0004, 0x0005, 0x0006}, {0x0007, 0x0008, 0x0009}},
+    {{0x000A, 0x000B, 0x000C}, {0x000D, 0x000E, 0x000F}},
+};
+
+void layer_lookup_cache_invalidate(void) {}
+void send_string_eeprom_macro(const void *addr, const void *end) {}
+}
+
+class DynamicKeymapMirror : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        dynamic_keymap_flush();
+    }
+
+    // Stands in for eeprom_driver_erase(), which clears the EEPROM behind the mirror's back
+    void erase(void) {
+        uint8_t *base = (uint8_t *)dynamic_keymap_key_to_eeprom_address(0, 0, 0);
+        for (int i = 0; i < DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2; i++) {
+            eeprom_write_byte(base + i, 0x00);
+        }
+    }
+
+    uint16_t stored(uint8_t layer, uint8_t row, uint8_t column) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+
+    void expect_defaults_stored(void) {
+        for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                    EXPECT_EQ(stored(layer, row, column), keymaps[layer][row][column]);
+                }
+            }
+        }
+    }
+};
+
+TEST_F(DynamicKeymapMirror, ResetAfterEraseRewritesEveryKey) {
+    erase();
+    dynamic_keymap_mirror_invalidate();
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 1, 2), 0x0000);
+
+    dynamic_keymap_reset();
+    dynamic_keymap_flush();
+    expect_defaults_stored();
+}
+
+TEST_F(DynamicKeymapMirror, ResetIsFlushedByTask) {
+    dynamic_keymap_set_keycode(0, 1, 1, 0x0029);
+    dynamic_keymap_flush();
+    EXPECT_EQ(stored(0, 1, 1), 0x0029);
+
+    dynamic_keymap_reset();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), 0x0008);
+    EXPECT_EQ(stored(0, 1, 1), 0x0029);
+
+    advance_time(DYNAMIC_KEYMAP_FLUSH_DELAY - 1);
+    dynamic_keymap_task();
+    EXPECT_EQ(stored(0, 1, 1), 0x0029);
+
+    advance_time(1);
+    dynamic_keymap_task();
+    expect_defaults_stored();
+}
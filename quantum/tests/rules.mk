@@ -0,0 +1,11 @@
+dynamic_keymap_mirror_DEFS := \
+	-DMATRIX_ROWS=2 -DMATRIX_COLS=3 -DNO_DEBUG -DNO_PRINT \
+	-DEEPROM_CUSTOM -DEEPROM_SIZE=1024 -DDYNAMIC_KEYMAP_EEPROM_ADDR=64L \
+	-DDYNAMIC_KEYMAP_ENABLE -DDYNAMIC_KEYMAP_RAM_MIRROR \
+	-DDYNAMIC_KEYMAP_LAYER_COUNT=2 -DDYNAMIC_KEYMAP_FLUSH_DELAY=100
+
+dynamic_keymap_mirror_SRC := \
+	$(QUANTUM_PATH)/tests/dynamic_keymap_mirror_tests.cpp \
+	$(QUANTUM_PATH)/dynamic_keymap.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
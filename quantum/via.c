@@ -47,6 +47,7 @@
 #include "eeprom.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 #include "via_ensure_keycode.h"
+#include "scan_stats.h"
 
 // Forward declare some helpers.
 #if defined(VIA_QMK_BACKLIGHT_ENABLE)
@@ -266,6 +267,12 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             }
             break;
         }
+#ifdef SCAN_STATS_ENABLE
+        case SCAN_STATS_RAW_HID_ID: {
+            scan_stats_raw_hid_receive(data, length);
+            break;
+        }
+#endif
         case id_dynamic_keymap_get_keycode: {
             uint16_t keycode = dynamic_keymap_get_keycode(command_data[0], command_data[1], command_data[2]);
             command_data[3]  = keycode >> 8;
@@ -0,0 +1,93 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include "gtest/gtest.h"
+#include "backing_mocks.hpp"
+
+MockBackingStore mock_backing_store;
+
+void MockBackingStore::reset(void) {
+    memset(data, 0xFF, sizeof(data));
+    memset(erase_count, 0, sizeof(erase_count));
+    halfword_writes             = 0;
+    halfword_reads              = 0;
+    locked                      = true;
+    operations_until_power_loss = -1;
+}
+
+uint32_t MockBackingStore::total_erases(void) const {
+    uint32_t total = 0;
+    for (auto count : erase_count) {
+        total += count;
+    }
+    return total;
+}
+
+uint16_t MockBackingStore::read(uint32_t address) const {
+    return data[address] | (data[address + 1] << 8);
+}
+
+static bool power_lost(void) {
+    auto &store = mock_backing_store;
+    if (store.operations_until_power_loss < 0) {
+        return false;
+    }
+    if (store.operations_until_power_loss == 0) {
+        return true;
+    }
+    store.operations_until_power_loss--;
+    return false;
+}
+
+extern "C" bool backing_store_init(void) {
+    return true;
+}
+
+extern "C" bool backing_store_unlock(void) {
+    mock_backing_store.locked = false;
+    return true;
+}
+
+extern "C" bool backing_store_erase(uint32_t address) {
+    auto &store = mock_backing_store;
+    EXPECT_FALSE(store.locked) << "erase while locked";
+    EXPECT_EQ(address % BACKING_STORE_ERASE_SIZE, 0) << "unaligned erase at " << address;
+    if (store.locked || address >= WEAR_LEVELING_BACKING_SIZE) {
+        return false;
+    }
+    if (power_lost()) {
+        return true;
+    }
+    memset(&store.data[address], 0xFF, BACKING_STORE_ERASE_SIZE);
+    store.erase_count[address / BACKING_STORE_ERASE_SIZE]++;
+    return true;
+}
+
+extern "C" bool backing_store_write(uint32_t address, uint16_t value) {
+    auto &store = mock_backing_store;
+    EXPECT_FALSE(store.locked) << "write while locked";
+    EXPECT_EQ(address % 2, 0) << "unaligned write at " << address;
+    if (store.locked || address >= WEAR_LEVELING_BACKING_SIZE) {
+        return false;
+    }
+    if (power_lost()) {
+        return true;
+    }
+    EXPECT_EQ(store.read(address), 0xFFFF) << "programming a halfword that has not been erased at " << address;
+    store.data[address]     = value & 0xFF;
+    store.data[address + 1] = value >> 8;
+    store.halfword_writes++;
+    return true;
+}
+
+extern "C" bool backing_store_lock(void) {
+    mock_backing_store.locked = true;
+    return true;
+}
+
+extern "C" bool backing_store_read(uint32_t address, uint16_t *value) {
+    mock_backing_store.halfword_reads++;
+    *value = mock_backing_store.read(address);
+    return true;
+}
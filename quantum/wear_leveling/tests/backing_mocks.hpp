@@ -0,0 +1,27 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include "wear_leveling_internal.h"
+
+#define MOCK_BACKING_STORE_BLOCKS (WEAR_LEVELING_BACKING_SIZE / BACKING_STORE_ERASE_SIZE)
+
+/* Simulated NOR flash: erased blocks read 0xFF and a halfword can only be programmed once per erase */
+struct MockBackingStore {
+    uint8_t  data[WEAR_LEVELING_BACKING_SIZE];
+    uint32_t erase_count[MOCK_BACKING_STORE_BLOCKS];
+    uint32_t halfword_writes;
+    uint32_t halfword_reads;
+    bool     locked;
+
+    // Number of erases and writes still performed before a simulated power loss, negative to disable
+    int32_t operations_until_power_loss;
+
+    void     reset(void);
+    uint32_t total_erases(void) const;
+    uint16_t read(uint32_t address) const;
+};
+
+extern MockBackingStore mock_backing_store;
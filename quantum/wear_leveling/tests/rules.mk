@@ -0,0 +1,12 @@
+wear_leveling_DEFS := \
+	-DWEAR_LEVELING_BACKING_SIZE=1024 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DBACKING_STORE_ERASE_SIZE=128
+
+wear_leveling_INC := \
+	$(QUANTUM_PATH)/wear_leveling
+
+wear_leveling_SRC := \
+	$(QUANTUM_PATH)/wear_leveling/tests/backing_mocks.cpp \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_tests.cpp \
+	$(QUANTUM_PATH)/wear_leveling/wear_leveling.c
@@ -0,0 +1,228 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <iostream>
+#include "gtest/gtest.h"
+#include "backing_mocks.hpp"
+
+#define LOG_THRESHOLD (WEAR_LEVELING_LOG_ENTRIES - WEAR_LEVELING_COMPACT_RESERVE)
+#define COMPACTION_STEPS (WEAR_LEVELING_BANK_BLOCKS + (WEAR_LEVELING_LOGICAL_SIZE / 2 + WEAR_LEVELING_COMPACT_STEP - 1) / WEAR_LEVELING_COMPACT_STEP)
+
+class WearLeveling : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_backing_store.reset();
+        ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+        memset(shadow, 0, sizeof(shadow));
+    }
+
+    void write(uint32_t address, const void *value, size_t length) {
+        ASSERT_EQ(wear_leveling_write(address, value, length), WEAR_LEVELING_SUCCESS);
+        memcpy(&shadow[address], value, length);
+    }
+
+    void write_byte(uint32_t address, uint8_t value) {
+        write(address, &value, 1);
+    }
+
+    void expect_shadow(void) {
+        uint8_t contents[WEAR_LEVELING_LOGICAL_SIZE];
+        ASSERT_EQ(wear_leveling_read(0, contents, sizeof(contents)), WEAR_LEVELING_SUCCESS);
+        for (uint32_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; i++) {
+            EXPECT_EQ(contents[i], shadow[i]) << "at address " << i;
+        }
+    }
+
+    void reboot(void) {
+        mock_backing_store.operations_until_power_loss = -1;
+        ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+    }
+
+    // Fills the write log up to the point where compaction starts
+    void fill_log(void) {
+        for (uint32_t i = 0; !wear_leveling_compaction_pending(); i++) {
+            ASSERT_LT(i, WEAR_LEVELING_LOG_ENTRIES);
+            write_byte(i % WEAR_LEVELING_LOGICAL_SIZE, i + 1);
+        }
+    }
+
+    uint8_t shadow[WEAR_LEVELING_LOGICAL_SIZE];
+};
+
+TEST_F(WearLeveling, BlankStoreIsFormatted) {
+    EXPECT_EQ(mock_backing_store.total_erases(), MOCK_BACKING_STORE_BLOCKS);
+    EXPECT_EQ(mock_backing_store.read(0), WEAR_LEVELING_MAGIC);
+    EXPECT_FALSE(wear_leveling_compaction_pending());
+    expect_shadow();
+}
+
+TEST_F(WearLeveling, ReadsAreServedFromRam) {
+    uint8_t data[] = {0x12, 0x34, 0x56};
+    write(5, data, sizeof(data));
+
+    uint32_t reads = mock_backing_store.halfword_reads;
+    uint8_t  value[sizeof(data)];
+    ASSERT_EQ(wear_leveling_read(5, value, sizeof(value)), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(memcmp(value, data, sizeof(data)), 0);
+    EXPECT_EQ(mock_backing_store.halfword_reads, reads);
+}
+
+TEST_F(WearLeveling, OutOfRangeAccessFails) {
+    uint8_t value[2] = {0};
+    EXPECT_EQ(wear_leveling_read(WEAR_LEVELING_LOGICAL_SIZE - 1, value, 2), WEAR_LEVELING_FAILED);
+    EXPECT_EQ(wear_leveling_write(WEAR_LEVELING_LOGICAL_SIZE - 1, value, 2), WEAR_LEVELING_FAILED);
+}
+
+TEST_F(WearLeveling, WritesSurviveReboot) {
+    uint8_t data[] = {0xDE, 0xAD, 0xBE, 0xEF, 0xFF};
+    write(3, data, sizeof(data));
+    write_byte(WEAR_LEVELING_LOGICAL_SIZE - 1, 0x42);
+    write_byte(4, 0x00);
+
+    reboot();
+    expect_shadow();
+}
+
+TEST_F(WearLeveling, UnchangedDataIsNotLogged) {
+    uint8_t data[] = {1, 2, 3, 4};
+    write(8, data, sizeof(data));
+    uint32_t writes = mock_backing_store.halfword_writes;
+
+    write(8, data, sizeof(data));
+    EXPECT_EQ(mock_backing_store.halfword_writes, writes);
+}
+
+TEST_F(WearLeveling, CompactionIsSpreadAcrossTasks) {
+    uint32_t erases = mock_backing_store.total_erases();
+    fill_log();
+    EXPECT_EQ(mock_backing_store.total_erases(), erases) << "writes must not erase while the log has space";
+
+    uint32_t steps = 0;
+    while (wear_leveling_compaction_pending()) {
+        uint32_t before = mock_backing_store.total_erases();
+        wear_leveling_task();
+        EXPECT_LE(mock_backing_store.total_erases() - before, 1);
+        ASSERT_LT(++steps, 100);
+    }
+    EXPECT_EQ(steps, COMPACTION_STEPS);
+    EXPECT_EQ(mock_backing_store.total_erases(), erases + WEAR_LEVELING_BANK_BLOCKS);
+    EXPECT_EQ(mock_backing_store.read(WEAR_LEVELING_BANK_SIZE), WEAR_LEVELING_MAGIC);
+    expect_shadow();
+
+    reboot();
+    EXPECT_FALSE(wear_leveling_compaction_pending());
+    expect_shadow();
+}
+
+TEST_F(WearLeveling, WritesDuringCompactionSurviveBankSwitch) {
+    fill_log();
+    for (uint32_t i = 0; i < WEAR_LEVELING_BANK_BLOCKS + 1; i++) {
+        wear_leveling_task();
+    }
+
+    // One halfword that has already been copied into the spare bank, one that has not
+    write_byte(0, 0xA5);
+    write_byte(WEAR_LEVELING_LOGICAL_SIZE - 2, 0x5A);
+
+    // Interrupted before the switch, the old bank still holds everything
+    reboot();
+    expect_shadow();
+    EXPECT_TRUE(wear_leveling_compaction_pending());
+
+    fill_log();
+    for (uint32_t i = 0; i < WEAR_LEVELING_BANK_BLOCKS + 1; i++) {
+        wear_leveling_task();
+    }
+    write_byte(1, 0x11);
+    write_byte(WEAR_LEVELING_LOGICAL_SIZE - 1, 0x22);
+    while (wear_leveling_compaction_pending()) {
+        wear_leveling_task();
+    }
+    expect_shadow();
+
+    reboot();
+    expect_shadow();
+}
+
+TEST_F(WearLeveling, FullLogFallsBackToBlockingCompaction) {
+    for (uint32_t i = 0; i < 3 * WEAR_LEVELING_LOG_ENTRIES; i++) {
+        write_byte((i * 7) % WEAR_LEVELING_LOGICAL_SIZE, i);
+    }
+    EXPECT_GE(mock_backing_store.total_erases(), MOCK_BACKING_STORE_BLOCKS + 2 * WEAR_LEVELING_BANK_BLOCKS);
+    expect_shadow();
+
+    reboot();
+    expect_shadow();
+}
+
+TEST_F(WearLeveling, TornLogEntryIsIgnored) {
+    write_byte(10, 0x33);
+    mock_backing_store.operations_until_power_loss = 1;
+    EXPECT_EQ(wear_leveling_write(12, "\x44\x55", 2), WEAR_LEVELING_SUCCESS);
+
+    reboot();
+    expect_shadow();
+
+    write_byte(12, 0x66);
+    reboot();
+    expect_shadow();
+}
+
+TEST_F(WearLeveling, InterruptedCompactionKeepsOldBank) {
+    fill_log();
+    for (uint32_t i = 0; i < WEAR_LEVELING_BANK_BLOCKS + 1; i++) {
+        wear_leveling_task();
+    }
+    mock_backing_store.operations_until_power_loss = 2;
+    while (wear_leveling_compaction_pending()) {
+        wear_leveling_task();
+    }
+
+    reboot();
+    expect_shadow();
+}
+
+TEST_F(WearLeveling, EraseCountsAndWriteAmplification) {
+    const uint32_t writes        = 20000;
+    uint32_t       changed_bytes = 0;
+    uint32_t       state         = 12345;
+
+    uint32_t base_erases = mock_backing_store.total_erases();
+    uint32_t base_writes = mock_backing_store.halfword_writes;
+    for (uint32_t i = 0; i < writes; i++) {
+        state            = state * 1103515245 + 12345;
+        uint32_t address = (state >> 8) % WEAR_LEVELING_LOGICAL_SIZE;
+        uint32_t length  = 1 + ((state >> 20) % 4);
+        if (address + length > WEAR_LEVELING_LOGICAL_SIZE) {
+            length = WEAR_LEVELING_LOGICAL_SIZE - address;
+        }
+
+        uint8_t data[4];
+        for (uint32_t j = 0; j < length; j++) {
+            data[j] = state >> (j * 8);
+            changed_bytes += data[j] != shadow[address + j];
+        }
+        write(address, data, length);
+        wear_leveling_task();
+    }
+    expect_shadow();
+
+    uint32_t erases        = mock_backing_store.total_erases() - base_erases;
+    double   amplification = 2.0 * (mock_backing_store.halfword_writes - base_writes) / changed_bytes;
+    uint32_t min_erases = UINT32_MAX, max_erases = 0;
+    for (auto count : mock_backing_store.erase_count) {
+        min_erases = std::min(min_erases, count);
+        max_erases = std::max(max_erases, count);
+    }
+    std::cout << "[ STATS    ] " << changed_bytes << " bytes changed, " << erases << " block erases, erase count per block " << min_erases << "-" << max_erases << ", write amplification " << amplification << std::endl;
+
+    // Every block of both banks wears at the same rate
+    EXPECT_LE(max_erases - min_erases, 1);
+    // A log entry takes two halfwords, plus the compacted image once per log
+    EXPECT_LT(amplification, 4.0);
+    EXPECT_LE(erases, WEAR_LEVELING_BANK_BLOCKS * (writes * 2 / LOG_THRESHOLD + 1));
+
+    reboot();
+    expect_shadow();
+}
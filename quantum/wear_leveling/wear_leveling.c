@@ -0,0 +1,257 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "wear_leveling.h"
+#include "wear_leveling_internal.h"
+
+typedef enum {
+    COMPACTION_IDLE,
+    COMPACTION_ERASING,
+    COMPACTION_COPYING,
+} compaction_state_t;
+
+__attribute__((aligned(2))) static uint8_t cache[WEAR_LEVELING_LOGICAL_SIZE];
+
+static uint8_t  active_bank = 0;
+static uint16_t sequence    = 0;
+static uint32_t log_entries = 0;
+
+static compaction_state_t compaction_state    = COMPACTION_IDLE;
+static uint32_t           compaction_position = 0; // erase block during COMPACTION_ERASING, halfword during COMPACTION_COPYING
+static uint32_t           spare_log_entries   = 0;
+
+static inline uint32_t bank_address(uint8_t bank, uint32_t offset) {
+    return (uint32_t)bank * WEAR_LEVELING_BANK_SIZE + offset;
+}
+
+static inline uint16_t cache_halfword(uint32_t index) {
+    return cache[2 * index] | (cache[2 * index + 1] << 8);
+}
+
+static inline uint16_t read_halfword(uint32_t address) {
+    uint16_t value = 0xFFFF;
+    backing_store_read(address, &value);
+    return value;
+}
+
+static bool read_header(uint8_t bank, uint16_t *header_sequence) {
+    *header_sequence = read_halfword(bank_address(bank, 2));
+    return read_halfword(bank_address(bank, 0)) == WEAR_LEVELING_MAGIC;
+}
+
+/** \brief Programs a halfword, skipping values that blank flash already holds */
+static bool program_halfword(uint32_t address, uint16_t value) {
+    return value == 0xFFFF || backing_store_write(address, value);
+}
+
+static bool write_header(uint8_t bank, uint16_t header_sequence) {
+    // The magic is written last, so an interrupted header leaves the bank invalid
+    bool ok = backing_store_unlock();
+    ok      = ok && program_halfword(bank_address(bank, 2), header_sequence);
+    ok      = ok && program_halfword(bank_address(bank, 0), WEAR_LEVELING_MAGIC);
+    return backing_store_lock() && ok;
+}
+
+static bool write_log_entry(uint8_t bank, uint32_t slot, uint32_t index, uint16_t value) {
+    uint32_t address = bank_address(bank, WEAR_LEVELING_LOG_OFFSET + slot * WEAR_LEVELING_LOG_ENTRY_SIZE);
+    bool     ok      = backing_store_unlock();
+    ok               = ok && program_halfword(address, value);
+    ok               = ok && backing_store_write(address + 2, index);
+    return backing_store_lock() && ok;
+}
+
+/** \brief Rebuilds the RAM image from a bank's compacted image and write log */
+static void load_bank(uint8_t bank) {
+    for (uint32_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE / 2; i++) {
+        uint16_t value   = ~read_halfword(bank_address(bank, WEAR_LEVELING_IMAGE_OFFSET + 2 * i));
+        cache[2 * i]     = value & 0xFF;
+        cache[2 * i + 1] = value >> 8;
+    }
+
+    log_entries = WEAR_LEVELING_LOG_ENTRIES;
+    for (uint32_t slot = 0; slot < WEAR_LEVELING_LOG_ENTRIES; slot++) {
+        uint32_t address = bank_address(bank, WEAR_LEVELING_LOG_OFFSET + slot * WEAR_LEVELING_LOG_ENTRY_SIZE);
+        uint16_t value   = read_halfword(address);
+        uint16_t index   = read_halfword(address + 2);
+        if (index == 0xFFFF && value == 0xFFFF) {
+            log_entries = slot;
+            break;
+        }
+        // Entries torn by a reset, and anything else that is not a valid index, are skipped
+        if (index < WEAR_LEVELING_LOGICAL_SIZE / 2) {
+            cache[2 * index]     = value & 0xFF;
+            cache[2 * index + 1] = value >> 8;
+        }
+    }
+}
+
+/** \brief Performs a single compaction step, copying at most `budget` halfwords */
+static bool compaction_step(uint32_t budget) {
+    uint8_t spare_bank = active_bank ^ 1;
+    bool    ok         = true;
+
+    switch (compaction_state) {
+        case COMPACTION_IDLE:
+            break;
+
+        case COMPACTION_ERASING:
+            ok = backing_store_unlock();
+            ok = ok && backing_store_erase(bank_address(spare_bank, compaction_position * BACKING_STORE_ERASE_SIZE));
+            ok = backing_store_lock() && ok;
+            if (++compaction_position == WEAR_LEVELING_BANK_BLOCKS) {
+                compaction_state    = COMPACTION_COPYING;
+                compaction_position = 0;
+                spare_log_entries   = 0;
+            }
+            break;
+
+        case COMPACTION_COPYING:
+            ok = backing_store_unlock();
+            while (ok && budget-- > 0 && compaction_position < WEAR_LEVELING_LOGICAL_SIZE / 2) {
+                ok = program_halfword(bank_address(spare_bank, WEAR_LEVELING_IMAGE_OFFSET + 2 * compaction_position), ~cache_halfword(compaction_position));
+                compaction_position++;
+            }
+            ok = backing_store_lock() && ok;
+            if (ok && compaction_position == WEAR_LEVELING_LOGICAL_SIZE / 2) {
+                ok = write_header(spare_bank, sequence + 1);
+                if (ok) {
+                    active_bank      = spare_bank;
+                    log_entries      = spare_log_entries;
+                    compaction_state = COMPACTION_IDLE;
+                    sequence++;
+                }
+            }
+            break;
+    }
+
+    if (!ok) {
+        // Start over with a fresh erase of the spare bank on the next step
+        compaction_state    = COMPACTION_ERASING;
+        compaction_position = 0;
+    }
+    return ok;
+}
+
+static void compaction_start(void) {
+    if (compaction_state == COMPACTION_IDLE) {
+        compaction_state    = COMPACTION_ERASING;
+        compaction_position = 0;
+    }
+}
+
+/** \brief Completes the compaction in one go, used when the write log has run out of space */
+static bool compaction_finish(void) {
+    compaction_start();
+    for (uint8_t retries = 0; compaction_state != COMPACTION_IDLE;) {
+        if (!compaction_step(UINT32_MAX) && ++retries > 3) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool append_halfword(uint32_t index, uint16_t value) {
+    // Halfwords already copied into the spare bank would be lost on the bank switch, so they are logged there too
+    if (compaction_state == COMPACTION_COPYING && index < compaction_position) {
+        if (!write_log_entry(active_bank ^ 1, spare_log_entries++, index, value)) {
+            compaction_state    = COMPACTION_ERASING;
+            compaction_position = 0;
+        }
+    }
+
+    if (log_entries >= WEAR_LEVELING_LOG_ENTRIES) {
+        // The RAM image already holds the new value, so the compacted bank includes it
+        return compaction_finish();
+    }
+
+    if (!write_log_entry(active_bank, log_entries++, index, value)) {
+        return false;
+    }
+
+    if (log_entries >= WEAR_LEVELING_LOG_ENTRIES - WEAR_LEVELING_COMPACT_RESERVE) {
+        compaction_start();
+    }
+    return true;
+}
+
+wear_leveling_status_t wear_leveling_erase(void) {
+    memset(cache, 0, sizeof(cache));
+    compaction_state = COMPACTION_IDLE;
+    active_bank      = 0;
+    sequence         = 0;
+    log_entries      = 0;
+
+    bool ok = backing_store_unlock();
+    for (uint32_t address = 0; ok && address < WEAR_LEVELING_BACKING_SIZE; address += BACKING_STORE_ERASE_SIZE) {
+        ok = backing_store_erase(address);
+    }
+    ok = backing_store_lock() && ok;
+    ok = ok && write_header(active_bank, sequence);
+    return ok ? WEAR_LEVELING_SUCCESS : WEAR_LEVELING_FAILED;
+}
+
+wear_leveling_status_t wear_leveling_init(void) {
+    if (!backing_store_init()) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    compaction_state = COMPACTION_IDLE;
+
+    uint16_t sequences[2];
+    bool     valid[2] = {read_header(0, &sequences[0]), read_header(1, &sequences[1])};
+    if (!valid[0] && !valid[1]) {
+        return wear_leveling_erase();
+    }
+
+    if (valid[0] && valid[1]) {
+        active_bank = (int16_t)(sequences[1] - sequences[0]) > 0 ? 1 : 0;
+    } else {
+        active_bank = valid[1] ? 1 : 0;
+    }
+    sequence = sequences[active_bank];
+    load_bank(active_bank);
+
+    if (log_entries >= WEAR_LEVELING_LOG_ENTRIES - WEAR_LEVELING_COMPACT_RESERVE) {
+        compaction_start();
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+
+wear_leveling_status_t wear_leveling_read(uint32_t address, void *value, size_t length) {
+    if (address + length > WEAR_LEVELING_LOGICAL_SIZE) {
+        return WEAR_LEVELING_FAILED;
+    }
+    memcpy(value, &cache[address], length);
+    return WEAR_LEVELING_SUCCESS;
+}
+
+wear_leveling_status_t wear_leveling_write(uint32_t address, const void *value, size_t length) {
+    if (address + length > WEAR_LEVELING_LOGICAL_SIZE) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    const uint8_t *data = (const uint8_t *)value;
+    bool           ok   = true;
+    for (uint32_t index = address / 2; length > 0 && index <= (address + length - 1) / 2; index++) {
+        uint16_t old_value = cache_halfword(index);
+        for (uint32_t byte = 2 * index; byte < 2 * index + 2; byte++) {
+            if (byte >= address && byte < address + length) {
+                cache[byte] = data[byte - address];
+            }
+        }
+        uint16_t new_value = cache_halfword(index);
+        if (new_value != old_value) {
+            ok = append_halfword(index, new_value) && ok;
+        }
+    }
+    return ok ? WEAR_LEVELING_SUCCESS : WEAR_LEVELING_FAILED;
+}
+
+void wear_leveling_task(void) {
+    compaction_step(WEAR_LEVELING_COMPACT_STEP);
+}
+
+bool wear_leveling_compaction_pending(void) {
+    return compaction_state != COMPACTION_IDLE;
+}
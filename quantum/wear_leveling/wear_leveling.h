@@ -0,0 +1,45 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(WEAR_LEVELING_EMBEDDED_FLASH)
+#    include "wear_leveling_efl_config.h"
+#endif
+
+/** \brief Total size of the backing store, split into two equally sized banks */
+#ifndef WEAR_LEVELING_BACKING_SIZE
+#    error WEAR_LEVELING_BACKING_SIZE has not been defined by the backing store driver
+#endif
+
+/** \brief Size of the emulated EEPROM, kept in RAM as a full image */
+#ifndef WEAR_LEVELING_LOGICAL_SIZE
+#    define WEAR_LEVELING_LOGICAL_SIZE (WEAR_LEVELING_BACKING_SIZE / 4)
+#endif
+
+typedef enum {
+    WEAR_LEVELING_SUCCESS,
+    WEAR_LEVELING_FAILED,
+} wear_leveling_status_t;
+
+/** \brief Loads the RAM image from the newest valid bank, formatting the backing store if none is found */
+wear_leveling_status_t wear_leveling_init(void);
+
+/** \brief Clears the RAM image and formats the backing store */
+wear_leveling_status_t wear_leveling_erase(void);
+
+/** \brief Copies data out of the RAM image, never touching the backing store */
+wear_leveling_status_t wear_leveling_read(uint32_t address, void *value, size_t length);
+
+/** \brief Updates the RAM image and appends every changed halfword to the write log */
+wear_leveling_status_t wear_leveling_write(uint32_t address, const void *value, size_t length);
+
+/** \brief Advances a pending compaction by one step, i.e. a single block erase or a few halfword writes */
+void wear_leveling_task(void);
+
+/** \brief Returns whether a compaction has been started and not yet finished */
+bool wear_leveling_compaction_pending(void);
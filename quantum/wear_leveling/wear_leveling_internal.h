@@ -0,0 +1,75 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "wear_leveling.h"
+
+/*
+ * Backing store layout, all values are little endian halfwords:
+ *
+ *   bank 0: [magic][sequence][compacted image: LOGICAL_SIZE bytes][write log: 4 bytes per entry ...]
+ *   bank 1: [magic][sequence][compacted image: LOGICAL_SIZE bytes][write log: 4 bytes per entry ...]
+ *
+ * The compacted image is stored inverted so that blank flash reads as zeroes. A log entry holds the new value
+ * followed by the halfword index; the index is programmed last, so an entry is only applied once it is complete.
+ * The bank with a valid header and the newest sequence number is the active one. Compaction erases the other
+ * bank, copies the RAM image into it a few halfwords per wear_leveling_task() call and writes its header last.
+ */
+
+/** \brief Size of one erasable block of the backing store */
+#ifndef BACKING_STORE_ERASE_SIZE
+#    error BACKING_STORE_ERASE_SIZE has not been defined by the backing store driver
+#endif
+
+/** \brief Number of halfwords copied into the spare bank per wear_leveling_task() call */
+#ifndef WEAR_LEVELING_COMPACT_STEP
+#    define WEAR_LEVELING_COMPACT_STEP 16
+#endif
+
+#define WEAR_LEVELING_MAGIC 0x574C
+#define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE / 2)
+#define WEAR_LEVELING_BANK_BLOCKS (WEAR_LEVELING_BANK_SIZE / BACKING_STORE_ERASE_SIZE)
+#define WEAR_LEVELING_HEADER_SIZE 4
+#define WEAR_LEVELING_IMAGE_OFFSET WEAR_LEVELING_HEADER_SIZE
+#define WEAR_LEVELING_LOG_OFFSET (WEAR_LEVELING_IMAGE_OFFSET + WEAR_LEVELING_LOGICAL_SIZE)
+#define WEAR_LEVELING_LOG_ENTRY_SIZE 4
+#define WEAR_LEVELING_LOG_ENTRIES ((WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_OFFSET) / WEAR_LEVELING_LOG_ENTRY_SIZE)
+
+/** \brief Log entries kept free once compaction starts, so writes can continue while it runs in the background */
+#ifndef WEAR_LEVELING_COMPACT_RESERVE
+#    define WEAR_LEVELING_COMPACT_RESERVE (WEAR_LEVELING_LOG_ENTRIES / 4)
+#endif
+
+#if (WEAR_LEVELING_LOGICAL_SIZE % 2) != 0
+#    error WEAR_LEVELING_LOGICAL_SIZE must be even
+#endif
+#if (WEAR_LEVELING_BANK_SIZE % BACKING_STORE_ERASE_SIZE) != 0
+#    error WEAR_LEVELING_BACKING_SIZE must hold two banks made of whole erase blocks
+#endif
+#if WEAR_LEVELING_LOGICAL_SIZE / 2 >= 0xFFFF
+#    error WEAR_LEVELING_LOGICAL_SIZE is too large to be indexed by the write log
+#endif
+#if WEAR_LEVELING_COMPACT_RESERVE < 1 || (2 * WEAR_LEVELING_COMPACT_RESERVE + 1) >= WEAR_LEVELING_LOG_ENTRIES
+#    error wear leveling: the write log is too small, increase WEAR_LEVELING_BACKING_SIZE or decrease WEAR_LEVELING_LOGICAL_SIZE
+#endif
+
+/*
+ * Backing store driver interface, addresses are byte offsets from the start of the backing store.
+ */
+bool backing_store_init(void);
+bool backing_store_unlock(void);
+bool backing_store_erase(uint32_t address);
+bool backing_store_write(uint32_t address, uint16_t value);
+bool backing_store_lock(void);
+bool backing_store_read(uint32_t address, uint16_t *value);
+
+#ifdef __cplusplus
+}
+#endif
@@ -64,11 +64,8 @@ TEST_F(KeyPress, CorrectKeysAreReportedWhenTwoKeysArePressed) {
 
     key_b.press();
     key_c.press();
-    // Note that QMK only processes one key at a time
-    // See issue #1476 for more information
+    // Both changes are processed in the same scan, in matrix order
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_b.report_code)));
-    keyboard_task();
-
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_b.report_code, key_c.report_code)));
     keyboard_task();
 
@@ -76,12 +73,44 @@ TEST_F(KeyPress, CorrectKeysAreReportedWhenTwoKeysArePressed) {
     key_c.release();
     // Note that the first key released is the first one in the matrix order
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_c.report_code)));
-    keyboard_task();
-
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
     keyboard_task();
 }
 
+TEST_F(KeyPress, ChordIsReportedWithinOneScan) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_s = KeymapKey(0, 1, 0, KC_S);
+    auto       key_d = KeymapKey(0, 2, 1, KC_D);
+    auto       key_f = KeymapKey(0, 3, 2, KC_F);
+
+    set_keymap({key_a, key_s, key_d, key_f});
+
+    unsigned reports    = 0;
+    unsigned iterations = 0;
+    ON_CALL(driver, send_keyboard_mock(_)).WillByDefault([&](report_keyboard_t&) { reports++; });
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(4);
+
+    key_a.press();
+    key_s.press();
+    key_d.press();
+    key_f.press();
+    while (reports < 4 && iterations < 10) {
+        run_one_scan_loop();
+        iterations++;
+    }
+    EXPECT_EQ(iterations, 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(4);
+    key_a.release();
+    key_s.release();
+    key_d.release();
+    key_f.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
 TEST_F(KeyPress, LeftShiftIsReportedCorrectly) {
     TestDriver driver;
     auto       key_a    = KeymapKey(0, 0, 0, KC_A);
@@ -95,7 +124,6 @@ TEST_F(KeyPress, LeftShiftIsReportedCorrectly) {
     // Unfortunately modifiers are also processed in the wrong order
     // See issue #1476 for more information
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_a.report_code)));
-    keyboard_task();
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_a.report_code, key_lsft.report_code)));
     keyboard_task();
 
@@ -121,8 +149,6 @@ TEST_F(KeyPress, PressLeftShiftAndControl) {
     // Unfortunately modifiers are also processed in the wrong order
     // See issue #1476 for more information
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code)));
-    keyboard_task();
-
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code, key_lctrl.report_code)));
     keyboard_task();
 
@@ -130,8 +156,6 @@ TEST_F(KeyPress, PressLeftShiftAndControl) {
     key_lctrl.release();
 
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lctrl.report_code)));
-    keyboard_task();
-
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
     keyboard_task();
 }
@@ -148,8 +172,6 @@ TEST_F(KeyPress, LeftAndRightShiftCanBePressedAtTheSameTime) {
     // Unfortunately modifiers are also processed in the wrong order
     // See issue #1476 for more information
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code)));
-    keyboard_task();
-
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code, key_rsft.report_code)));
     keyboard_task();
 
@@ -157,8 +179,6 @@ TEST_F(KeyPress, LeftAndRightShiftCanBePressedAtTheSameTime) {
     key_rsft.release();
 
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_rsft.report_code)));
-    keyboard_task();
-
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
     keyboard_task();
 }
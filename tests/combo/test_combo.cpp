@@ -0,0 +1,166 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <iostream>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+#define COMBO_BENCHMARK_MAX 500
+
+extern "C" {
+void advance_time(uint32_t ms);
+
+combo_t  key_combos[COMBO_BENCHMARK_MAX];
+uint16_t COMBO_LEN = 0;
+}
+
+const uint16_t PROGMEM ab_combo[] = {KC_A, KC_B, COMBO_END};
+const uint16_t PROGMEM bc_combo[] = {KC_B, KC_C, COMBO_END};
+
+class Combo : public TestFixture {
+   protected:
+    void SetUp() override {
+        /* The combo timer treats a start time of 0 as not running. */
+        advance_time(1);
+
+        key_combos[0] = (combo_t)COMBO(ab_combo, KC_Z);
+        key_combos[1] = (combo_t)COMBO(bc_combo, KC_Y);
+        COMBO_LEN     = 2;
+    }
+};
+
+TEST_F(Combo, ComboKeysPressedTogetherSendComboKeycode) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    key_a.press();
+    key_b.press();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Z)));
+    idle_for(COMBO_TERM + 2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_a.release();
+    key_b.release();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    idle_for(COMBO_TERM + 2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, SecondComboSharingAKeySendsItsKeycode) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({key_b, key_c});
+
+    key_b.press();
+    key_c.press();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Y)));
+    idle_for(COMBO_TERM + 2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_b.release();
+    key_c.release();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    idle_for(COMBO_TERM + 2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, SingleComboKeyIsSentAfterComboTerm) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    key_a.press();
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    idle_for(COMBO_TERM + 2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_a.release();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, NonComboKeyIsSentImmediately) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+
+    set_keymap({key_d});
+
+    key_d.press();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_D)));
+    run_one_scan_loop();
+    key_d.release();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, BenchmarkNonComboKeyEvent) {
+    using clock              = std::chrono::steady_clock;
+    constexpr int iterations = 10000;
+
+    static uint16_t combo_keys[COMBO_BENCHMARK_MAX][3];
+    for (uint16_t i = 0; i < COMBO_BENCHMARK_MAX; i++) {
+        combo_keys[i][0] = KC_F1 + (i % 12);
+        combo_keys[i][1] = KC_KP_1 + (i / 12 % 10);
+        combo_keys[i][2] = COMBO_END;
+    }
+
+    for (uint16_t combos : {10, 100, 500}) {
+        for (uint16_t i = 0; i < combos; i++) {
+            key_combos[i] = (combo_t)COMBO(combo_keys[i], KC_Z);
+        }
+        COMBO_LEN = combos;
+
+        keyrecord_t record = {};
+        record.event.key   = (keypos_t){.col = 3, .row = 0};
+
+        auto start = clock::now();
+        for (int i = 0; i < iterations; i++) {
+            record.event.pressed = true;
+            record.event.time    = timer_read() | 1;
+            EXPECT_TRUE(process_combo(KC_D, &record));
+            record.event.pressed = false;
+            EXPECT_TRUE(process_combo(KC_D, &record));
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+
+        std::cout << "[ BENCHMARK] " << combos << " combos: " << elapsed / (iterations * 2) << " ns/event" << std::endl;
+    }
+
+    COMBO_LEN = 0;
+}
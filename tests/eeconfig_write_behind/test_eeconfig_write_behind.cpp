@@ -0,0 +1,86 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "eeprom.h"
+#include "eeconfig.h"
+}
+
+using testing::_;
+
+class EeconfigWriteBehind : public TestFixture {
+   protected:
+    void SetUp() override {
+        eeconfig_flush();
+    }
+};
+
+TEST_F(EeconfigWriteBehind, UpdatesAreWrittenBackAfterDelay) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+
+    uint32_t stored = eeprom_read_dword(EECONFIG_KEYBOARD);
+    eeconfig_update_kb(0x11223344);
+    eeconfig_update_kb(0x55667788);
+    EXPECT_EQ(eeconfig_read_kb(), 0x55667788);
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_KEYBOARD), stored);
+
+    idle_for(EECONFIG_FLUSH_DELAY - 1);
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_KEYBOARD), stored);
+
+    idle_for(2);
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_KEYBOARD), 0x55667788);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(EeconfigWriteBehind, FlushIsSlicedAcrossScans) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+
+    // EECONFIG_KEYBOARD and EECONFIG_USER are adjacent, so they form one dirty run of eight bytes
+    eeconfig_update_kb(0xA1A2A3A4);
+    eeconfig_update_user(0xB1B2B3B4);
+    idle_for(EECONFIG_FLUSH_DELAY);
+    while (eeprom_read_dword(EECONFIG_KEYBOARD) != 0xA1A2A3A4) {
+        run_one_scan_loop();
+    }
+    EXPECT_NE(eeprom_read_dword(EECONFIG_USER), 0xB1B2B3B4);
+
+    run_one_scan_loop();
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_USER), 0xB1B2B3B4);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(EeconfigWriteBehind, FlushWritesPendingUpdatesImmediately) {
+    eeconfig_update_debug(0x5A);
+    eeconfig_update_handedness(true);
+    EXPECT_EQ(eeconfig_read_debug(), 0x5A);
+
+    eeconfig_flush();
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEBUG), 0x5A);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_HANDEDNESS), 1);
+}
+
+TEST_F(EeconfigWriteBehind, ReadsPastEeconfigAreaAreNotMirrored) {
+    uint8_t *address = (uint8_t *)(EECONFIG_SIZE + 1);
+    eeconfig_update_byte(address, 0x42);
+    EXPECT_EQ(eeprom_read_byte(address), 0x42);
+    EXPECT_EQ(eeconfig_read_byte(address), 0x42);
+}
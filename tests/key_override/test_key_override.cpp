@@ -0,0 +1,191 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::AtLeast;
+using testing::InSequence;
+
+extern "C" uint32_t key_override_bench_clock(void) {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// ko_make_basic() relies on out-of-order designated initializers, which C++ rejects.
+static key_override_t make_override(uint8_t trigger_mods, uint16_t trigger, uint16_t replacement) {
+    key_override_t override = {};
+    override.trigger         = trigger;
+    override.trigger_mods    = trigger_mods;
+    override.layers          = ~0;
+    override.suppressed_mods = trigger_mods;
+    override.replacement     = replacement;
+    override.options         = ko_options_default;
+    return override;
+}
+
+const key_override_t delete_override = make_override(MOD_MASK_SHIFT, KC_BACKSPACE, KC_DELETE);
+const key_override_t a_to_b_override = make_override(MOD_MASK_SHIFT, KC_A, KC_B);
+const key_override_t a_to_c_override = make_override(MOD_MASK_SHIFT, KC_A, KC_C);
+
+const key_override_t *overrides[] = {&delete_override, &a_to_b_override, &a_to_c_override, NULL};
+
+class KeyOverride : public TestFixture {
+   protected:
+    void SetUp() override {
+        key_overrides = overrides;
+    }
+    void TearDown() override {
+        key_overrides = NULL;
+    }
+};
+
+TEST_F(KeyOverride, TriggerWithModifierSendsReplacement) {
+    TestDriver driver;
+    auto       key_lsft = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_bspc = KeymapKey(0, 1, 0, KC_BACKSPACE);
+
+    set_keymap({key_lsft, key_bspc});
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    key_lsft.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_DELETE))).Times(AtLeast(1));
+    key_bspc.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AtLeast(1));
+    key_bspc.release();
+    key_lsft.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, TriggerWithoutModifierIsSentUnchanged) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_bspc = KeymapKey(0, 1, 0, KC_BACKSPACE);
+
+    set_keymap({key_bspc});
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+    key_bspc.press();
+    run_one_scan_loop();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    key_bspc.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, FirstMatchingOverrideWins) {
+    TestDriver driver;
+    auto       key_lsft = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_a    = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({key_lsft, key_a});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_C))).Times(0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B))).Times(AtLeast(1));
+    key_lsft.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    key_a.release();
+    key_lsft.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, ModifierAfterTriggerActivatesAfterRepeatDelay) {
+    TestDriver driver;
+    auto       key_lsft = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_bspc = KeymapKey(0, 1, 0, KC_BACKSPACE);
+
+    set_keymap({key_lsft, key_bspc});
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+    key_bspc.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_DELETE))).Times(0);
+    key_lsft.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_DELETE))).Times(AtLeast(1));
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    key_bspc.release();
+    key_lsft.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, BenchmarkKeyEventWithModifierHeld) {
+    constexpr int iterations = 10000;
+
+    for (uint16_t count : {10, 100, 250}) {
+        std::vector<key_override_t>         storage;
+        std::vector<const key_override_t *> pointers;
+        for (uint16_t i = 0; i < count; i++) {
+            storage.push_back(make_override(MOD_MASK_SHIFT, KC_F1 + (i % 24), KC_A + (i % 26)));
+        }
+        for (auto &override : storage) {
+            pointers.push_back(&override);
+        }
+        pointers.push_back(NULL);
+        key_overrides = pointers.data();
+
+        keyrecord_t record = {};
+        record.event.key   = (keypos_t){.col = 3, .row = 0};
+
+        add_mods(MOD_BIT(KC_LSFT));
+        key_override_reset_bench();
+        for (int i = 0; i < iterations; i++) {
+            record.event.pressed = true;
+            record.event.time    = timer_read() | 1;
+            EXPECT_TRUE(process_key_override(KC_1, &record));
+            record.event.pressed = false;
+            EXPECT_TRUE(process_key_override(KC_1, &record));
+        }
+        del_mods(MOD_BIT(KC_LSFT));
+
+        const key_override_bench_t *bench = key_override_get_bench();
+        EXPECT_EQ(bench->events, iterations * 2);
+        std::cout << "[ BENCHMARK] " << count << " key overrides: " << bench->total / bench->events << " ns/event, max " << bench->max << " ns" << std::endl;
+    }
+
+    key_overrides = NULL;
+}
@@ -0,0 +1,140 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <iostream>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerLookupCache : public TestFixture {
+   protected:
+    static constexpr uint8_t layers = 32;
+    static constexpr uint8_t keys   = 10;
+
+    /* All layers are transparent apart from the base layer and one key on layer 17. */
+    void set_deep_keymap() {
+        for (uint8_t layer = 0; layer < layers; layer++) {
+            for (uint8_t col = 0; col < keys; col++) {
+                uint16_t keycode = KC_TRANSPARENT;
+                if (layer == 0) {
+                    keycode = KC_A + col;
+                } else if (layer == 17 && col == 3) {
+                    keycode = KC_1;
+                }
+                add_key(KeymapKey(layer, col, 0, keycode));
+            }
+        }
+    }
+};
+
+TEST_F(LayerLookupCache, LayerChangeInvalidatesCachedLayer) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(1, 0, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    key_a.press();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    run_one_scan_loop();
+    key_a.release();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    layer_on(1);
+    key_b.press();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+    run_one_scan_loop();
+    key_b.release();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    layer_off(1);
+    key_a.press();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    run_one_scan_loop();
+    key_a.release();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(LayerLookupCache, KeymapChangeInvalidatesCachedLayer) {
+    auto key_a = KeymapKey(0, 0, 0, KC_A);
+    auto key_b = KeymapKey(1, 0, 0, KC_TRANSPARENT);
+
+    set_keymap({key_a, key_b});
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_B)});
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+}
+
+TEST_F(LayerLookupCache, CachedLookupMatchesLayerWalk) {
+    set_deep_keymap();
+    layer_or(~(layer_state_t)0);
+
+    for (uint8_t col = 0; col < keys; col++) {
+        keypos_t key = {.col = col, .row = 0};
+        layer_lookup_cache_invalidate();
+        uint8_t resolved = layer_switch_get_layer(key);
+        EXPECT_EQ(resolved, col == 3 ? 17 : 0);
+        EXPECT_EQ(layer_switch_get_layer(key), resolved);
+    }
+
+    layer_off(17);
+    EXPECT_EQ(layer_switch_get_layer((keypos_t){.col = 3, .row = 0}), 0);
+}
+
+TEST_F(LayerLookupCache, BenchmarkThirtyTwoLayers) {
+    using clock              = std::chrono::steady_clock;
+    constexpr int iterations = 1000;
+
+    set_deep_keymap();
+    layer_or(~(layer_state_t)0);
+
+    unsigned checksum_walk = 0;
+    auto     start         = clock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (uint8_t col = 0; col < keys; col++) {
+            layer_lookup_cache_invalidate();
+            checksum_walk += layer_switch_get_layer((keypos_t){.col = col, .row = 0});
+        }
+    }
+    auto walk = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+
+    unsigned checksum_cached = 0;
+    start                    = clock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (uint8_t col = 0; col < keys; col++) {
+            checksum_cached += layer_switch_get_layer((keypos_t){.col = col, .row = 0});
+        }
+    }
+    auto cached = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+
+    EXPECT_EQ(checksum_walk, checksum_cached);
+    std::cout << "[ BENCHMARK] " << +layers << " layers, layer walk: " << walk / (iterations * keys) << " ns/lookup, cached: " << cached / (iterations * keys) << " ns/lookup" << std::endl;
+}
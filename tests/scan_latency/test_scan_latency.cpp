@@ -0,0 +1,342 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+extern "C" {
+void advance_time(uint32_t ms);
+
+combo_t  key_combos[1];
+uint16_t COMBO_LEN = 0;
+}
+
+/* Typing traces: a new key every TRACE_MIN_GAP-TRACE_MAX_GAP ms, each held for TRACE_MIN_HOLD-TRACE_MAX_HOLD ms,
+ * so consecutive keys often overlap. Holds stay below TAPPING_TERM and AUTO_SHIFT_TIMEOUT, so every key is a tap. */
+#define TRACE_MIN_GAP 60
+#define TRACE_MAX_GAP 220
+#define TRACE_MIN_HOLD 50
+#define TRACE_MAX_HOLD 130
+
+static const std::string trace_text = "the quick brown fox jumps over the lazy dog. pack my box with five dozen liquor jugs. how vexingly quick daft zebras jump. sphinx of black quartz, judge my vow. the five boxing wizards jump quickly.";
+
+static const char *const layout[] = {"qwertyuiop", "asdfghjkl;", "zxcvbnm,./", " "};
+
+struct TraceEvent {
+    uint32_t time;
+    char     key;
+    bool     pressed;
+};
+
+struct ReplayResult {
+    std::vector<uint32_t> latency_ms;
+    std::vector<uint32_t> latency_scans;
+    std::string           typed;
+    uint32_t              unmatched_presses = 0;
+    uint32_t              reports_with_mods = 0;
+    uint32_t              events            = 0;
+    uint32_t              scans             = 0;
+    uint64_t              task_ns           = 0;
+};
+
+static uint16_t basic_keycode(char c) {
+    switch (c) {
+        case ' ':
+            return KC_SPACE;
+        case ';':
+            return KC_SEMICOLON;
+        case ',':
+            return KC_COMMA;
+        case '.':
+            return KC_DOT;
+        case '/':
+            return KC_SLASH;
+        default:
+            return KC_A + (c - 'a');
+    }
+}
+
+static char basic_char(uint8_t keycode) {
+    for (auto row : layout) {
+        for (const char *c = row; *c; c++) {
+            if (basic_keycode(*c) == keycode) {
+                return *c;
+            }
+        }
+    }
+    return '?';
+}
+
+static std::vector<TraceEvent> make_trace(const std::string &text, uint32_t seed) {
+    std::mt19937                    rng(seed);
+    std::uniform_int_distribution<> gap(TRACE_MIN_GAP, TRACE_MAX_GAP);
+    std::uniform_int_distribution<> hold(TRACE_MIN_HOLD, TRACE_MAX_HOLD);
+    std::vector<TraceEvent>         trace;
+    uint32_t                        released[128] = {0};
+    uint32_t                        time          = 0;
+
+    for (char c : text) {
+        time += gap(rng);
+        // A key can only be pressed again once it has been released
+        time = std::max(time, released[(uint8_t)c] + TRACE_MIN_GAP / 2);
+
+        uint32_t release        = time + hold(rng);
+        released[(uint8_t)c] = release;
+        trace.push_back({time, c, true});
+        trace.push_back({release, c, false});
+    }
+    std::stable_sort(trace.begin(), trace.end(), [](const TraceEvent &a, const TraceEvent &b) { return a.time < b.time; });
+    return trace;
+}
+
+static uint32_t percentile(std::vector<uint32_t> values, unsigned percent) {
+    std::sort(values.begin(), values.end());
+    return values.empty() ? 0 : values[(values.size() - 1) * percent / 100];
+}
+
+static void print_result(const char *name, const ReplayResult &result) {
+    std::cout << "[ LATENCY  ] " << name << ": " << result.latency_ms.size() << " keys, latency p50/p90/p99/max " << percentile(result.latency_ms, 50) << "/" << percentile(result.latency_ms, 90) << "/" << percentile(result.latency_ms, 99) << "/" << percentile(result.latency_ms, 100) << " ms, " << percentile(result.latency_scans, 50) << "/" << percentile(result.latency_scans, 90) << "/" << percentile(result.latency_scans, 99) << "/" << percentile(result.latency_scans, 100) << " scans, keyboard_task() " << result.task_ns / result.scans << " ns per scan, " << result.task_ns / result.events << " ns per event" << std::endl;
+}
+
+class ScanLatency : public TestFixture {
+   protected:
+    void SetUp() override {
+        /* The combo timer treats a start time of 0 as not running. */
+        advance_time(1);
+
+        autoshift_disable();
+        COMBO_LEN     = 0;
+        key_overrides = NULL;
+    }
+
+    void TearDown() override {
+        autoshift_disable();
+        COMBO_LEN     = 0;
+        key_overrides = NULL;
+    }
+
+    void build_keymap(bool home_row_mods) {
+        static const uint16_t home_row_mod_taps[] = {LGUI_T(KC_A), LALT_T(KC_S), LCTL_T(KC_D), LSFT_T(KC_F), KC_G, KC_H, RSFT_T(KC_J), RCTL_T(KC_K), LALT_T(KC_L), RGUI_T(KC_SEMICOLON)};
+
+        set_keymap({});
+        keys.clear();
+        for (uint8_t row = 0; row < sizeof(layout) / sizeof(layout[0]); row++) {
+            for (uint8_t col = 0; layout[row][col]; col++) {
+                char     c       = layout[row][col];
+                uint16_t keycode = basic_keycode(c);
+                if (home_row_mods && row == 1) {
+                    keycode = home_row_mod_taps[col];
+                }
+                keys.emplace_back(c, KeymapKey(0, col, row, keycode, basic_keycode(c)));
+                add_key(keys.back().second);
+            }
+        }
+        // Never pressed by the traces, but key overrides look at them on every event
+        add_key(KeymapKey(0, 1, 3, KC_BACKSPACE));
+        add_key(KeymapKey(0, 2, 3, KC_LEFT_SHIFT));
+    }
+
+    void enable_combos(void) {
+        combo_keys[0] = key_for('j').code;
+        combo_keys[1] = key_for('k').code;
+        combo_keys[2] = COMBO_END;
+        key_combos[0] = (combo_t)COMBO(combo_keys, KC_ESCAPE);
+        COMBO_LEN     = 1;
+    }
+
+    void enable_key_overrides(void) {
+        delete_override.trigger         = KC_BACKSPACE;
+        delete_override.trigger_mods    = MOD_MASK_SHIFT;
+        delete_override.layers          = ~0;
+        delete_override.suppressed_mods = MOD_MASK_SHIFT;
+        delete_override.replacement     = KC_DELETE;
+        delete_override.options         = ko_options_default;
+        overrides[0]                    = &delete_override;
+        overrides[1]                    = NULL;
+        key_overrides                   = overrides;
+    }
+
+    KeymapKey &key_for(char c) {
+        for (auto &key : keys) {
+            if (key.first == c) {
+                return key.second;
+            }
+        }
+        ADD_FAILURE() << "No key for character '" << c << "'";
+        return keys.front().second;
+    }
+
+    /* Replays the trace one scan per millisecond, timing each keyboard_task() call and matching every key press to
+     * the first report that adds its keycode */
+    ReplayResult replay(const std::vector<TraceEvent> &trace) {
+        struct PendingPress {
+            uint8_t  keycode;
+            uint32_t time;
+            uint32_t scan;
+        };
+
+        TestDriver               driver;
+        ReplayResult             result;
+        std::deque<PendingPress> pending;
+        std::vector<uint8_t>     previous_keys;
+        uint32_t                 start = timer_read32();
+
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) {
+            std::vector<uint8_t> report_keys;
+            for (size_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                if (report.keys[i]) {
+                    report_keys.push_back(report.keys[i]);
+                }
+            }
+            result.reports_with_mods += report.mods != 0;
+
+            for (auto keycode : report_keys) {
+                if (std::find(previous_keys.begin(), previous_keys.end(), keycode) != previous_keys.end()) {
+                    continue;
+                }
+                result.typed += basic_char(keycode);
+
+                auto press = std::find_if(pending.begin(), pending.end(), [&](const PendingPress &p) { return p.keycode == keycode; });
+                if (press != pending.end()) {
+                    result.latency_ms.push_back(timer_read32() - press->time);
+                    result.latency_scans.push_back(result.scans - press->scan + 1);
+                    pending.erase(press);
+                }
+            }
+            previous_keys = report_keys;
+        }));
+
+        // Keep scanning after the last event until anything still held back has been sent
+        auto     next = trace.begin();
+        uint32_t end  = trace.back().time + TAPPING_TERM * 2;
+        for (uint32_t time = 0; time <= end; time++) {
+            for (; next != trace.end() && next->time == time; ++next) {
+                KeymapKey &key = key_for(next->key);
+                if (next->pressed) {
+                    key.press();
+                    pending.push_back({(uint8_t)key.report_code, start + time, result.scans + 1});
+                } else {
+                    key.release();
+                }
+                result.events++;
+            }
+
+            result.scans++;
+            auto begin = std::chrono::steady_clock::now();
+            keyboard_task();
+            result.task_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+            advance_time(1);
+        }
+
+        result.unmatched_presses = pending.size();
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return result;
+    }
+
+    void expect_trace_typed(const ReplayResult &result) {
+        EXPECT_EQ(result.typed, trace_text);
+        EXPECT_EQ(result.unmatched_presses, 0);
+        EXPECT_EQ(result.reports_with_mods, 0);
+        EXPECT_EQ(result.latency_ms.size(), trace_text.size());
+    }
+
+    std::vector<std::pair<char, KeymapKey>> keys;
+    uint16_t                                combo_keys[3];
+    key_override_t                          delete_override;
+    const key_override_t *                  overrides[2];
+};
+
+TEST_F(ScanLatency, PlainKeys) {
+    build_keymap(false);
+
+    auto result = replay(make_trace(trace_text, 1));
+    print_result("plain keys", result);
+    expect_trace_typed(result);
+    EXPECT_EQ(percentile(result.latency_ms, 100), 0);
+    EXPECT_EQ(percentile(result.latency_scans, 100), 1);
+}
+
+TEST_F(ScanLatency, ReplayIsDeterministic) {
+    build_keymap(true);
+    enable_combos();
+
+    auto trace  = make_trace(trace_text, 2);
+    auto first  = replay(trace);
+    auto second = replay(trace);
+    EXPECT_EQ(first.typed, second.typed);
+    EXPECT_EQ(first.latency_ms, second.latency_ms);
+    EXPECT_EQ(first.latency_scans, second.latency_scans);
+}
+
+TEST_F(ScanLatency, HomeRowModTaps) {
+    build_keymap(true);
+
+    auto result = replay(make_trace(trace_text, 1));
+    print_result("home row mod-taps", result);
+    expect_trace_typed(result);
+    // A mod-tap is resolved on release, and holds back the keys pressed after it until then
+    EXPECT_LE(percentile(result.latency_ms, 100), TRACE_MAX_HOLD);
+    EXPECT_EQ(percentile(result.latency_ms, 50), 0);
+}
+
+TEST_F(ScanLatency, AutoShift) {
+    build_keymap(false);
+    autoshift_enable();
+
+    auto result = replay(make_trace(trace_text, 1));
+    print_result("auto shift", result);
+    expect_trace_typed(result);
+    // Auto-shifted keys are sent on release, or when the next key is pressed
+    EXPECT_LE(percentile(result.latency_ms, 100), TRACE_MAX_HOLD);
+}
+
+TEST_F(ScanLatency, CombosAndKeyOverrides) {
+    build_keymap(false);
+    enable_combos();
+    enable_key_overrides();
+
+    auto result = replay(make_trace(trace_text, 1));
+    print_result("combos and key overrides", result);
+    expect_trace_typed(result);
+    // Only keys that are part of a combo wait, until the scan after COMBO_TERM at most
+    EXPECT_LE(percentile(result.latency_ms, 100), COMBO_TERM + 1);
+    EXPECT_EQ(percentile(result.latency_ms, 90), 0);
+}
+
+TEST_F(ScanLatency, FullPipeline) {
+    build_keymap(true);
+    autoshift_enable();
+    enable_combos();
+    enable_key_overrides();
+
+    auto result = replay(make_trace(trace_text, 1));
+    print_result("full pipeline", result);
+    expect_trace_typed(result);
+    EXPECT_LE(percentile(result.latency_ms, 100), TRACE_MAX_HOLD + COMBO_TERM + 1);
+}
@@ -0,0 +1,157 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "scan_stats.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+static uint16_t slow_key_delay_ms = 0;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.pressed && slow_key_delay_ms) {
+        advance_time(slow_key_delay_ms);
+    }
+    return true;
+}
+
+// The reply is written back into the request, as for a keymap forwarding its raw HID reports
+static std::vector<uint8_t> raw_hid_request(std::vector<uint8_t> request) {
+    request.resize(32);
+    scan_stats_raw_hid_receive(request.data(), request.size());
+    return request;
+}
+
+static uint32_t read_be(const std::vector<uint8_t> &data, size_t offset, size_t size) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value = (value << 8) | data[offset + i];
+    }
+    return value;
+}
+
+class ScanStats : public TestFixture {
+   protected:
+    void SetUp() override {
+        slow_key_delay_ms = 0;
+        scan_stats_clear();
+    }
+};
+
+TEST_F(ScanStats, SlowKeyEventIsRecorded) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    slow_key_delay_ms = 3;
+    key_a.press();
+    run_one_scan_loop();
+    key_a.release();
+    idle_for(SCAN_STATS_WINDOW_MS);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    const scan_stats_window_t *window = scan_stats_get_window(0);
+    ASSERT_NE(window, nullptr);
+    EXPECT_EQ(window->sequence, 0);
+    EXPECT_GE(window->duration_ms, SCAN_STATS_WINDOW_MS);
+
+    const scan_stats_record_t *key_events = &window->sections[SCAN_STATS_KEY_EVENTS];
+    EXPECT_GT(key_events->count, 1);
+    EXPECT_EQ(key_events->min_us, 0);
+    EXPECT_EQ(key_events->max_us, 3000);
+    EXPECT_EQ(key_events->total_us, 3000);
+    EXPECT_EQ(key_events->histogram[0], key_events->count - 1);
+    EXPECT_EQ(key_events->histogram[5], 1);
+
+    const scan_stats_record_t *keyboard_task = &window->sections[SCAN_STATS_KEYBOARD_TASK];
+    EXPECT_EQ(keyboard_task->count, key_events->count);
+    EXPECT_EQ(keyboard_task->max_us, 3000);
+    EXPECT_EQ(window->sections[SCAN_STATS_QUANTUM_TASK].count, key_events->count);
+    EXPECT_EQ(window->sections[SCAN_STATS_QUANTUM_TASK].max_us, 0);
+    EXPECT_EQ(window->sections[SCAN_STATS_OLED_TASK].count, 0);
+}
+
+TEST_F(ScanStats, HistoryKeepsMostRecentWindows) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(SCAN_STATS_WINDOW_MS * (SCAN_STATS_HISTORY + 2));
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    for (uint8_t age = 0; age < SCAN_STATS_HISTORY; age++) {
+        const scan_stats_window_t *window = scan_stats_get_window(age);
+        ASSERT_NE(window, nullptr);
+        EXPECT_EQ(window->sequence, SCAN_STATS_HISTORY - age);
+        EXPECT_EQ(window->sections[SCAN_STATS_KEYBOARD_TASK].count, SCAN_STATS_WINDOW_MS);
+    }
+    EXPECT_EQ(scan_stats_get_window(SCAN_STATS_HISTORY), nullptr);
+}
+
+TEST_F(ScanStats, RawHidReportsWindow) {
+    TestDriver driver;
+
+    // The window closes in the first scan after SCAN_STATS_WINDOW_MS, so it holds one extra scan
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(SCAN_STATS_WINDOW_MS + 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    auto info = raw_hid_request({SCAN_STATS_RAW_HID_ID, scan_stats_get_info});
+    EXPECT_EQ(info[0], SCAN_STATS_RAW_HID_ID);
+    EXPECT_EQ(info[1], scan_stats_get_info);
+    EXPECT_EQ(info[2], SCAN_STATS_PROTOCOL_VERSION);
+    EXPECT_EQ(info[3], SCAN_STATS_SECTION_COUNT);
+    EXPECT_EQ(info[4], SCAN_STATS_HISTORY);
+    EXPECT_EQ(info[5], SCAN_STATS_HISTOGRAM_BUCKETS);
+    EXPECT_EQ(read_be(info, 6, 2), SCAN_STATS_WINDOW_MS);
+    EXPECT_EQ(read_be(info, 8, 2), 0);
+    EXPECT_EQ(info[10], 1);
+
+    auto summary = raw_hid_request({SCAN_STATS_RAW_HID_ID, scan_stats_get_summary, 0, SCAN_STATS_KEYBOARD_TASK});
+    EXPECT_EQ(summary[1], scan_stats_get_summary);
+    EXPECT_EQ(read_be(summary, 4, 2), 0);
+    EXPECT_EQ(read_be(summary, 6, 2), SCAN_STATS_WINDOW_MS);
+    EXPECT_EQ(read_be(summary, 8, 4), SCAN_STATS_WINDOW_MS + 1);
+    EXPECT_EQ(read_be(summary, 12, 4), 0);
+    EXPECT_EQ(read_be(summary, 16, 2), 0);
+    EXPECT_EQ(read_be(summary, 18, 2), 0);
+
+    auto histogram = raw_hid_request({SCAN_STATS_RAW_HID_ID, scan_stats_get_histogram, 0, SCAN_STATS_KEYBOARD_TASK});
+    EXPECT_EQ(histogram[1], scan_stats_get_histogram);
+    EXPECT_EQ(read_be(histogram, 6, 2), SCAN_STATS_WINDOW_MS + 1);
+    for (uint8_t i = 1; i < SCAN_STATS_HISTOGRAM_BUCKETS; i++) {
+        EXPECT_EQ(read_be(histogram, 6 + 2 * i, 2), 0);
+    }
+
+    EXPECT_EQ(raw_hid_request({SCAN_STATS_RAW_HID_ID, scan_stats_get_summary, 1, SCAN_STATS_KEYBOARD_TASK})[1], scan_stats_unhandled);
+    EXPECT_EQ(raw_hid_request({SCAN_STATS_RAW_HID_ID, scan_stats_get_summary, 0, SCAN_STATS_SECTION_COUNT})[1], scan_stats_unhandled);
+    EXPECT_EQ(raw_hid_request({SCAN_STATS_RAW_HID_ID, 0x42})[1], scan_stats_unhandled);
+
+    raw_hid_request({SCAN_STATS_RAW_HID_ID, scan_stats_reset});
+    EXPECT_EQ(scan_stats_get_window(0), nullptr);
+}
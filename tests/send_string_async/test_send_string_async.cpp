@@ -0,0 +1,201 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+#include "eeprom.h"
+}
+
+static std::vector<bool> completions;
+
+static void record_completion(bool completed) {
+    completions.push_back(completed);
+}
+
+class SendStringAsync : public TestFixture {
+   protected:
+    void SetUp() override {
+        completions.clear();
+    }
+
+    void TearDown() override {
+        send_string_async_cancel();
+    }
+};
+
+TEST_F(SendStringAsync, TypesOneCharacterPerScan) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    EXPECT_TRUE(send_string_async("ab", record_completion));
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_TRUE(completions.empty());
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    EXPECT_EQ(completions, std::vector<bool>({true}));
+    EXPECT_FALSE(send_string_async_is_busy());
+}
+
+TEST_F(SendStringAsync, KeysAreProcessedWhileSending) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_c = KeymapKey(0, 0, 0, KC_C);
+
+    set_keymap({key_c});
+
+    EXPECT_TRUE(send_string_with_delay_async("ab", 50, record_completion));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_C)));
+    key_c.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    key_c.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    idle_for(50);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, IntervalIsTimedNotCounted) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_with_delay_async_P(PSTR("ab"), 20, record_completion));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(19);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, DelayCodeIsHonoured) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(SEND_STRING_ASYNC(SS_DOWN(X_LSFT) SS_DELAY(30) "a" SS_UP(X_LSFT), record_completion));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(30);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT, KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    idle_for(3);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(completions, std::vector<bool>({true}));
+}
+
+TEST_F(SendStringAsync, CancelReleasesHeldKeysAndDropsQueue) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(SEND_STRING_ASYNC(SS_DOWN(X_LCTL) "abc" SS_UP(X_LCTL), record_completion));
+    EXPECT_TRUE(send_string_async("def", record_completion));
+    EXPECT_FALSE(send_string_async("ghi", record_completion));
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL, KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL)));
+    idle_for(2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    send_string_async_cancel();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(completions, std::vector<bool>({false, false}));
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(10);
+    EXPECT_FALSE(send_string_async_is_busy());
+}
+
+TEST_F(SendStringAsync, EepromMacroUsesBareCodes) {
+    TestDriver driver;
+    InSequence s;
+    // dynamic keymap macros store SS_TAP(X_B) as "\1" followed by the keycode
+    const uint8_t macro[] = {'a', SS_TAP_CODE, KC_B, 0};
+    uint8_t *     addr    = (uint8_t *)64;
+    for (uint8_t i = 0; i < sizeof(macro); i++) {
+        eeprom_update_byte(addr + i, macro[i]);
+    }
+
+    EXPECT_TRUE(send_string_async_eeprom_macro(addr, addr + sizeof(macro), record_completion));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    idle_for(3);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(completions, std::vector<bool>({true}));
+}
+
+TEST_F(SendStringAsync, EepromMacroStopsAtEnd) {
+    TestDriver driver;
+    InSequence s;
+    // the macro area was rewritten while queued, and its terminator is past end
+    const uint8_t macro[] = {'a', 'b', 0};
+    uint8_t *     addr    = (uint8_t *)96;
+    for (uint8_t i = 0; i < sizeof(macro); i++) {
+        eeprom_update_byte(addr + i, macro[i]);
+    }
+
+    EXPECT_TRUE(send_string_async_eeprom_macro(addr, addr + 1, record_completion));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    idle_for(3);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(completions, std::vector<bool>({true}));
+}
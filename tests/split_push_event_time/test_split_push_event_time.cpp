@@ -0,0 +1,90 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+// This half is the left one, rows 0 and 1 are local and rows 2 and 3 come from the slave
+static uint16_t slave_scan_age = 0;
+
+extern "C" {
+bool is_keyboard_left(void) {
+    return true;
+}
+
+bool is_keyboard_master(void) {
+    return true;
+}
+
+void split_pre_init(void) {}
+void split_post_init(void) {}
+
+uint16_t split_slave_matrix_scan_time(uint16_t now) {
+    return now - slave_scan_age;
+}
+}
+
+class SplitPushEventTime : public TestFixture {
+   protected:
+    void SetUp() override {
+        slave_scan_age = 0;
+    }
+};
+
+TEST_F(SplitPushEventTime, earlier_stamped_slave_press_does_not_resolve_master_mod_tap_as_hold) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       slave_key        = KeymapKey(0, 1, 2, KC_A);
+
+    set_keymap({mod_tap_hold_key, slave_key});
+
+    /* Press mod-tap-hold key on the master half. */
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Press a key on the slave half, which scanned it before the mod-tap-hold key was processed. */
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    slave_scan_age = 20;
+    slave_key.press();
+    run_one_scan_loop();
+    slave_scan_age = 0;
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Release slave key. */
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    slave_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Release mod-tap-hold key within the tapping term, it is a tap. */
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_P)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_P, KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_P)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
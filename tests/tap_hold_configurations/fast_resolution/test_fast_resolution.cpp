@@ -0,0 +1,188 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+struct TraceStep {
+    uint32_t   time;
+    KeymapKey *key;
+    bool       pressed;
+};
+
+struct TimedReport {
+    uint32_t             time;
+    std::vector<uint8_t> keys;
+
+    bool operator==(const TimedReport &other) const {
+        return time == other.time && keys == other.keys;
+    }
+};
+
+std::ostream &operator<<(std::ostream &stream, const TimedReport &report) {
+    stream << report.time << "ms:(";
+    for (auto key : report.keys) {
+        stream << " " << +key;
+    }
+    return stream << " )";
+}
+
+class FastResolution : public TestFixture {
+   protected:
+    /* Replays a timestamped press/release trace one scan per millisecond and returns every report sent,
+     * with its modifiers as keycodes, timed relative to the start of the trace */
+    std::vector<TimedReport> replay(std::vector<TraceStep> trace) {
+        TestDriver               driver;
+        std::vector<TimedReport> reports;
+        uint32_t                 time = 0;
+
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) {
+            TimedReport timed = {time, {}};
+            for (uint8_t mod = 0; mod < 8; mod++) {
+                if (report.mods & (1 << mod)) {
+                    timed.keys.push_back(KC_LEFT_CTRL + mod);
+                }
+            }
+            for (size_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                if (report.keys[i]) {
+                    timed.keys.push_back(report.keys[i]);
+                }
+            }
+            reports.push_back(timed);
+        }));
+
+        for (auto &step : trace) {
+            for (; time < step.time; time++) {
+                run_one_scan_loop();
+            }
+            if (step.pressed) {
+                step.key->press();
+            } else {
+                step.key->release();
+            }
+        }
+        for (uint32_t end = time + TAPPING_TERM * 2; time < end; time++) {
+            run_one_scan_loop();
+        }
+
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return reports;
+    }
+};
+
+TEST_F(FastResolution, mod_tap_key_in_typing_streak_is_tapped_on_next_press) {
+    auto regular_key      = KeymapKey(0, 0, 0, KC_B);
+    auto mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_A));
+    auto next_key         = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({regular_key, mod_tap_hold_key, next_key});
+
+    auto reports = replay({
+        {0, &regular_key, true},
+        {60, &regular_key, false},
+        {80, &mod_tap_hold_key, true},
+        {150, &next_key, true},
+        {200, &mod_tap_hold_key, false},
+        {230, &next_key, false},
+    });
+
+    std::vector<TimedReport> expected = {
+        {0, {KC_B}}, {60, {}}, {150, {KC_A}}, {150, {KC_A, KC_C}}, {200, {KC_C}}, {230, {}},
+    };
+    EXPECT_EQ(reports, expected);
+}
+
+TEST_F(FastResolution, mod_tap_key_after_pause_waits_for_release) {
+    auto regular_key      = KeymapKey(0, 0, 0, KC_B);
+    auto mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_A));
+    auto next_key         = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({regular_key, mod_tap_hold_key, next_key});
+
+    auto reports = replay({
+        {0, &regular_key, true},
+        {50, &regular_key, false},
+        {400, &mod_tap_hold_key, true},
+        {450, &next_key, true},
+        {480, &mod_tap_hold_key, false},
+        {520, &next_key, false},
+    });
+
+    std::vector<TimedReport> expected = {
+        {0, {KC_B}}, {50, {}}, {480, {KC_A}}, {480, {KC_A, KC_C}}, {480, {KC_C}}, {520, {}},
+    };
+    EXPECT_EQ(reports, expected);
+}
+
+TEST_F(FastResolution, slow_next_press_does_not_resolve_mod_tap_key) {
+    auto regular_key      = KeymapKey(0, 0, 0, KC_B);
+    auto mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_A));
+    auto next_key         = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({regular_key, mod_tap_hold_key, next_key});
+
+    /* Held past the tapping term, the mod-tap key becomes shift */
+    auto reports = replay({
+        {0, &regular_key, true},
+        {40, &regular_key, false},
+        {80, &mod_tap_hold_key, true},
+        {80 + TAPPING_STREAK_TERM, &next_key, true},
+        {80 + TAPPING_TERM + 20, &next_key, false},
+        {80 + TAPPING_TERM + 40, &mod_tap_hold_key, false},
+    });
+
+    std::vector<TimedReport> expected = {
+        {0, {KC_B}}, {40, {}}, {80 + TAPPING_TERM, {KC_LEFT_SHIFT}}, {80 + TAPPING_TERM, {KC_LEFT_SHIFT, KC_C}}, {80 + TAPPING_TERM + 20, {KC_LEFT_SHIFT}}, {80 + TAPPING_TERM + 40, {}},
+    };
+    EXPECT_EQ(reports, expected);
+}
+
+TEST_F(FastResolution, rolled_mod_tap_keys_in_typing_streak_are_tapped_in_order) {
+    auto regular_key       = KeymapKey(0, 0, 0, KC_B);
+    auto first_mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_A));
+    auto second_mod_tap    = KeymapKey(0, 2, 0, CTL_T(KC_S));
+    auto next_key          = KeymapKey(0, 3, 0, KC_C);
+
+    set_keymap({regular_key, first_mod_tap_key, second_mod_tap, next_key});
+
+    auto reports = replay({
+        {0, &regular_key, true},
+        {70, &first_mod_tap_key, true},
+        {100, &regular_key, false},
+        {140, &second_mod_tap, true},
+        {180, &first_mod_tap_key, false},
+        {210, &next_key, true},
+        {240, &second_mod_tap, false},
+        {260, &next_key, false},
+    });
+
+    std::vector<TimedReport> expected = {
+        {0, {KC_B}}, {100, {}}, {140, {KC_A}}, {180, {}}, {210, {KC_S}}, {210, {KC_S, KC_C}}, {240, {KC_C}}, {260, {}},
+    };
+    EXPECT_EQ(reports, expected);
+}
@@ -0,0 +1,103 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LargeWaitingBuffer : public TestFixture {};
+
+TEST_F(LargeWaitingBuffer, keys_typed_while_mod_tap_key_is_held_are_not_lost) {
+    TestDriver             driver;
+    InSequence             s;
+    auto                   mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    std::vector<KeymapKey> regular_keys;
+
+    /* Twelve taps need more entries than the default waiting buffer has */
+    for (uint8_t col = 0; col < 6; col++) {
+        regular_keys.emplace_back(0, col, 1, KC_A + col);
+        regular_keys.emplace_back(0, col, 2, KC_G + col);
+    }
+    ASSERT_GT(regular_keys.size() * 2, 8);
+    ASSERT_LE(regular_keys.size() * 2 + 1, WAITING_BUFFER_SIZE);
+
+    set_keymap({mod_tap_hold_key});
+    for (auto &key : regular_keys) {
+        add_key(key);
+    }
+
+    /* Press mod-tap-hold key */
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+
+    /* Tap every regular key within the tapping term */
+    for (auto &key : regular_keys) {
+        key.press();
+        run_one_scan_loop();
+        key.release();
+        run_one_scan_loop();
+    }
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Release mod-tap-hold key */
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_P)));
+    for (auto &key : regular_keys) {
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key.report_code, KC_P)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_P)));
+    }
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(LargeWaitingBuffer, mod_tap_key_is_resolved_after_buffer_wraps) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       regular_key      = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({mod_tap_hold_key, regular_key});
+
+    /* Each round leaves the buffer empty at a later position, until the positions wrap around */
+    for (int round = 0; round < WAITING_BUFFER_SIZE; round++) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+        mod_tap_hold_key.press();
+        run_one_scan_loop();
+        regular_key.press();
+        run_one_scan_loop();
+        regular_key.release();
+        run_one_scan_loop();
+        testing::Mock::VerifyAndClearExpectations(&driver);
+
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_P)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_P)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_P)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+        mod_tap_hold_key.release();
+        run_one_scan_loop();
+        idle_for(TAPPING_TERM);
+        testing::Mock::VerifyAndClearExpectations(&driver);
+    }
+}
@@ -99,10 +99,12 @@ void TestFixture::add_key(KeymapKey key) {
     }
 
     this->keymap.push_back(key);
+    layer_lookup_cache_invalidate();
 }
 
 void TestFixture::set_keymap(std::initializer_list<KeymapKey> keys) {
     this->keymap.clear();
+    layer_lookup_cache_invalidate();
     for (auto& key : keys) {
         add_key(key);
     }
@@ -0,0 +1,256 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+// "Hello" followed by four emoji, the last ones outside the Basic Multilingual Plane
+static const char *const test_string = "H\xC3\xA9llo \xE2\x98\x83\xE2\x9C\x93\xF0\x9F\x98\x80\xF0\x9F\x8E\x89";
+static const uint32_t    test_string_code_points = 10;
+
+typedef std::vector<uint8_t> Report;
+
+struct UnicodeRun {
+    std::vector<Report> reports;
+    uint32_t            duration_ms  = 0;
+    uint32_t            max_stall_ms = 0;
+};
+
+class UnicodeStream : public TestFixture {
+   protected:
+    /* Types the string with send_unicode_string(), which returns once everything is typed */
+    UnicodeRun run_blocking(uint8_t mode, uint8_t leds = 0) {
+        return record(mode, leds, [](UnicodeRun &run) {
+            uint32_t start = timer_read32();
+            send_unicode_string(test_string);
+            run.duration_ms = run.max_stall_ms = timer_read32() - start;
+        });
+    }
+
+    /* Types the string with the stream, one keyboard_task() per millisecond */
+    UnicodeRun run_stream(uint8_t mode, uint8_t leds = 0) {
+        return record(mode, leds, [](UnicodeRun &run) {
+            uint32_t start = timer_read32();
+            EXPECT_TRUE(send_unicode_string_async(test_string));
+            EXPECT_FALSE(send_unicode_string_async(test_string));
+            while (unicode_stream_is_busy()) {
+                uint32_t before = timer_read32();
+                keyboard_task();
+                run.max_stall_ms = std::max(run.max_stall_ms, timer_read32() - before);
+                advance_time(1);
+            }
+            run.duration_ms = timer_read32() - start;
+        });
+    }
+
+    /* Records every report sent through the driver as its list of pressed mods and keys */
+    void capture(TestDriver &driver, std::vector<Report> &reports) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&reports](report_keyboard_t &report) {
+            Report keys;
+            for (uint8_t mod = 0; mod < 8; mod++) {
+                if (report.mods & (1 << mod)) {
+                    keys.push_back(KC_LEFT_CTRL + mod);
+                }
+            }
+            for (size_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                if (report.keys[i]) {
+                    keys.push_back(report.keys[i]);
+                }
+            }
+            reports.push_back(keys);
+        }));
+    }
+
+    void print_throughput(const char *name, const UnicodeRun &blocking, const UnicodeRun &stream) {
+        std::cout << "[ UNICODE  ] " << name << ": " << test_string_code_points << " code points, blocking " << test_string_code_points * 1000.0 / blocking.duration_ms << " chars/s stalling " << blocking.max_stall_ms << " ms, stream " << test_string_code_points * 1000.0 / stream.duration_ms << " chars/s stalling " << stream.max_stall_ms << " ms" << std::endl;
+    }
+
+   private:
+    template <typename F>
+    UnicodeRun record(uint8_t mode, uint8_t leds, F type) {
+        TestDriver driver;
+        UnicodeRun run;
+
+        driver.set_leds(leds);
+        set_unicode_input_mode(mode);
+        capture(driver, run.reports);
+
+        type(run);
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return run;
+    }
+};
+
+TEST_F(UnicodeStream, LinuxOutputMatchesBlockingWithoutStalling) {
+    auto blocking = run_blocking(UC_LNX);
+    auto stream   = run_stream(UC_LNX);
+
+    EXPECT_EQ(stream.reports, blocking.reports);
+    EXPECT_EQ(stream.max_stall_ms, 0);
+    print_throughput("UC_LNX", blocking, stream);
+}
+
+TEST_F(UnicodeStream, WinComposeOutputMatchesBlockingWithoutStalling) {
+    auto blocking = run_blocking(UC_WINC);
+    auto stream   = run_stream(UC_WINC);
+
+    EXPECT_EQ(stream.reports, blocking.reports);
+    EXPECT_EQ(stream.max_stall_ms, 0);
+    print_throughput("UC_WINC", blocking, stream);
+}
+
+TEST_F(UnicodeStream, LinuxTogglesCapsLockOncePerString) {
+    auto blocking = run_blocking(UC_LNX, 1 << USB_LED_CAPS_LOCK);
+    auto stream   = run_stream(UC_LNX, 1 << USB_LED_CAPS_LOCK);
+
+    auto caps_presses = [](const UnicodeRun &run) {
+        return std::count(run.reports.begin(), run.reports.end(), Report({KC_CAPS_LOCK}));
+    };
+    EXPECT_EQ(caps_presses(blocking), 2 * test_string_code_points);
+    EXPECT_EQ(caps_presses(stream), 2);
+    EXPECT_LT(stream.duration_ms, blocking.duration_ms);
+    print_throughput("UC_LNX with Caps Lock", blocking, stream);
+}
+
+TEST_F(UnicodeStream, MacHoldsOptionForWholeString) {
+    auto blocking = run_blocking(UC_MAC);
+    auto stream   = run_stream(UC_MAC);
+
+    auto option_presses = [](const UnicodeRun &run) {
+        size_t presses = 0;
+        for (size_t i = 0; i < run.reports.size(); i++) {
+            if (run.reports[i] == Report({KC_LEFT_ALT}) && (i == 0 || run.reports[i - 1].empty())) {
+                presses++;
+            }
+        }
+        return presses;
+    };
+    EXPECT_EQ(option_presses(blocking), test_string_code_points);
+    EXPECT_EQ(option_presses(stream), 1);
+    EXPECT_EQ(stream.reports.back(), Report());
+    EXPECT_LT(stream.duration_ms, blocking.duration_ms);
+    print_throughput("UC_MAC", blocking, stream);
+}
+
+TEST_F(UnicodeStream, CancelAbandonsCurrentCodePoint) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    set_unicode_input_mode(UC_LNX);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    EXPECT_TRUE(send_unicode_string_async(test_string));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // the Ctrl+Shift+U sequence of the first code point is open
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_ESCAPE)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    unicode_stream_cancel();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    EXPECT_FALSE(unicode_stream_is_busy());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    key_a.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(UnicodeStream, OnlyModsStillHeldAreRestored) {
+    TestDriver          driver;
+    std::vector<Report> reports;
+    auto                key_alt   = KeymapKey(0, 0, 0, KC_LEFT_ALT);
+    auto                key_ctrl  = KeymapKey(0, 1, 0, KC_LEFT_CTRL);
+
+    set_keymap({key_alt, key_ctrl});
+    set_unicode_input_mode(UC_LNX);
+    capture(driver, reports);
+    key_alt.press();
+    key_ctrl.press();
+    run_one_scan_loop();
+
+    EXPECT_TRUE(send_unicode_string_async(test_string));
+    idle_for(5);
+    key_alt.release();
+    size_t released = reports.size();
+    run_one_scan_loop();
+    while (unicode_stream_is_busy()) {
+        run_one_scan_loop();
+    }
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Alt was released while typing and stays released, Ctrl is still held and is pressed again at the end
+    for (size_t i = released; i < reports.size(); i++) {
+        EXPECT_EQ(std::count(reports[i].begin(), reports[i].end(), KC_LEFT_ALT), 0);
+    }
+    EXPECT_EQ(reports.back(), Report({KC_LEFT_CTRL}));
+    key_ctrl.release();
+    run_one_scan_loop();
+}
+
+TEST_F(UnicodeStream, MacKeyWhileTypingReleasesOption) {
+    auto                uninterrupted = run_stream(UC_MAC);
+    TestDriver          driver;
+    std::vector<Report> reports;
+    auto                key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    capture(driver, reports);
+    EXPECT_TRUE(send_unicode_string_async(test_string));
+    run_one_scan_loop();
+    // Option is held for the first code point, none of its digits have been typed yet
+    EXPECT_EQ(reports.back(), Report({KC_LEFT_ALT}));
+
+    key_a.press();
+    run_one_scan_loop();
+    key_a.release();
+    while (unicode_stream_is_busy()) {
+        run_one_scan_loop();
+    }
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    auto digits = [](const std::vector<Report> &reports) {
+        std::vector<Report> typed;
+        std::copy_if(reports.begin(), reports.end(), std::back_inserter(typed), [](const Report &report) { return report.size() == 2 && report[0] == KC_LEFT_ALT; });
+        return typed;
+    };
+    for (const auto &report : reports) {
+        if (std::count(report.begin(), report.end(), KC_A)) {
+            EXPECT_EQ(report, Report({KC_A}));
+        }
+    }
+    EXPECT_EQ(digits(reports), digits(uninterrupted.reports));
+    EXPECT_EQ(reports.back(), Report());
+}
+
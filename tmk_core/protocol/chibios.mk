@@ -7,6 +7,7 @@ SRC += $(CHIBIOS_DIR)/chibios.c
 SRC += usb_descriptor.c
 SRC += $(CHIBIOS_DIR)/usb_driver.c
 SRC += $(CHIBIOS_DIR)/usb_util.c
+SRC += $(CHIBIOS_DIR)/keyboard_report_queue.c
 SRC += $(LIBSRC)
 
 VPATH += $(TMK_PATH)/$(PROTOCOL_DIR)
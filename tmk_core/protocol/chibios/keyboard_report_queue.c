@@ -0,0 +1,114 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+#include <string.h>
+#include "keyboard_report_queue.h"
+
+#define KEYBOARD_REPORT_QUEUE_ENTRY(i) keyboard_report_queue[(i) & (USB_KEYBOARD_REPORT_QUEUE_SIZE - 1)]
+
+/* head and tail run freely */
+static keyboard_report_entry_t keyboard_report_queue[USB_KEYBOARD_REPORT_QUEUE_SIZE];
+static uint8_t                 keyboard_report_queue_head = 0;
+static uint8_t                 keyboard_report_queue_tail = 0;
+/* the report currently (or last) on the wire, must outlive the transfer */
+static keyboard_report_entry_t keyboard_report_in_flight;
+
+#ifdef USB_KEYBOARD_REPORT_COALESCE
+/* true if every modifier and key held in b is also held in a */
+static bool keyboard_report_holds(const keyboard_report_entry_t *a, const keyboard_report_entry_t *b) {
+#    ifdef NKRO_ENABLE
+    if (b->nkro) {
+        if (b->report.nkro.mods & ~a->report.nkro.mods) {
+            return false;
+        }
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_BITS; i++) {
+            if (b->report.nkro.bits[i] & ~a->report.nkro.bits[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+#    endif
+    if (b->report.mods & ~a->report.mods) {
+        return false;
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (!b->report.keys[i]) {
+            continue;
+        }
+        bool held = false;
+        for (uint8_t j = 0; j < KEYBOARD_REPORT_KEYS && !held; j++) {
+            held = a->report.keys[j] == b->report.keys[i];
+        }
+        if (!held) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* last can be replaced by next if prev -> last -> next only presses, or only releases keys,
+ * so the host never misses a tap or sees keys change in a different order */
+static bool keyboard_report_can_coalesce(const keyboard_report_entry_t *prev, const keyboard_report_entry_t *last, const keyboard_report_entry_t *next) {
+    if (prev->nkro != last->nkro || last->nkro != next->nkro) {
+        return false;
+    }
+    return (keyboard_report_holds(last, prev) && keyboard_report_holds(next, last)) || (keyboard_report_holds(prev, last) && keyboard_report_holds(last, next));
+}
+#endif
+
+bool keyboard_report_queue_push(const keyboard_report_entry_t *entry) {
+    uint8_t count = keyboard_report_queue_head - keyboard_report_queue_tail;
+
+#ifdef USB_KEYBOARD_REPORT_COALESCE
+    if (count > 0) {
+        keyboard_report_entry_t *      last = &KEYBOARD_REPORT_QUEUE_ENTRY(keyboard_report_queue_head - 1);
+        const keyboard_report_entry_t *prev = count > 1 ? &KEYBOARD_REPORT_QUEUE_ENTRY(keyboard_report_queue_head - 2) : &keyboard_report_in_flight;
+        if (keyboard_report_can_coalesce(prev, last, entry)) {
+            *last = *entry;
+            return true;
+        }
+    }
+#endif
+
+    if (count == USB_KEYBOARD_REPORT_QUEUE_SIZE) {
+        return false;
+    }
+    KEYBOARD_REPORT_QUEUE_ENTRY(keyboard_report_queue_head) = *entry;
+    keyboard_report_queue_head++;
+    return true;
+}
+
+const keyboard_report_entry_t *keyboard_report_queue_peek(void) {
+    if (keyboard_report_queue_head == keyboard_report_queue_tail) {
+        return NULL;
+    }
+    return &KEYBOARD_REPORT_QUEUE_ENTRY(keyboard_report_queue_tail);
+}
+
+const keyboard_report_entry_t *keyboard_report_queue_pop(void) {
+    if (keyboard_report_queue_head == keyboard_report_queue_tail) {
+        return NULL;
+    }
+    keyboard_report_in_flight = KEYBOARD_REPORT_QUEUE_ENTRY(keyboard_report_queue_tail);
+    keyboard_report_queue_tail++;
+    return &keyboard_report_in_flight;
+}
+
+void keyboard_report_queue_clear(void) {
+    keyboard_report_queue_tail = keyboard_report_queue_head;
+    memset(&keyboard_report_in_flight, 0, sizeof(keyboard_report_in_flight));
+}
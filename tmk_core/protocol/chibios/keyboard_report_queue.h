@@ -0,0 +1,50 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "report.h"
+
+/* Keyboard reports waiting for the host to poll the endpoint, see USB_KEYBOARD_REPORT_QUEUE.
+ * None of these lock, usb_main.c calls them from locked state. */
+
+#ifndef USB_KEYBOARD_REPORT_QUEUE_SIZE
+#    define USB_KEYBOARD_REPORT_QUEUE_SIZE 8
+#endif
+#if (USB_KEYBOARD_REPORT_QUEUE_SIZE & (USB_KEYBOARD_REPORT_QUEUE_SIZE - 1)) != 0 || USB_KEYBOARD_REPORT_QUEUE_SIZE > 128
+#    error "USB_KEYBOARD_REPORT_QUEUE_SIZE must be a power of two no larger than 128"
+#endif
+
+typedef struct {
+    report_keyboard_t report;
+    bool              nkro;
+} keyboard_report_entry_t;
+
+/* appends entry, or merges it into the newest report where USB_KEYBOARD_REPORT_COALESCE allows it
+ * returns false if the queue is full and entry could not be merged */
+bool keyboard_report_queue_push(const keyboard_report_entry_t *entry);
+
+/* the oldest queued report, or NULL if the queue is empty */
+const keyboard_report_entry_t *keyboard_report_queue_peek(void);
+
+/* takes the oldest queued report off the queue, the returned copy stays valid until the next pop
+ * so it can be handed to a transfer; returns NULL if the queue is empty */
+const keyboard_report_entry_t *keyboard_report_queue_pop(void);
+
+/* drops every queued report and forgets the one on the wire */
+void keyboard_report_queue_clear(void);
@@ -0,0 +1,170 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <initializer_list>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "keyboard_report_queue.h"
+}
+
+static keyboard_report_entry_t report(uint8_t mods, std::initializer_list<uint8_t> keys) {
+    keyboard_report_entry_t entry = {};
+    entry.report.mods             = mods;
+    uint8_t i                     = 0;
+    for (uint8_t key : keys) {
+        entry.report.keys[i++] = key;
+    }
+    return entry;
+}
+
+class KeyboardReportQueue : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        keyboard_report_queue_clear();
+    }
+
+    void push(const keyboard_report_entry_t &entry) {
+        EXPECT_TRUE(keyboard_report_queue_push(&entry));
+    }
+
+    void expect_pop(const keyboard_report_entry_t &expected) {
+        const keyboard_report_entry_t *entry = keyboard_report_queue_pop();
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(memcmp(&entry->report, &expected.report, sizeof(expected.report)), 0);
+    }
+};
+
+TEST_F(KeyboardReportQueue, ReportsComeOutInOrder) {
+    push(report(0, {KC_A}));
+    push(report(0, {}));
+    push(report(MOD_BIT(KC_LEFT_SHIFT), {}));
+
+    expect_pop(report(0, {KC_A}));
+    expect_pop(report(0, {}));
+    expect_pop(report(MOD_BIT(KC_LEFT_SHIFT), {}));
+    EXPECT_EQ(keyboard_report_queue_pop(), nullptr);
+}
+
+TEST_F(KeyboardReportQueue, PeekLeavesTheReportQueued) {
+    push(report(0, {KC_A}));
+
+    const keyboard_report_entry_t *entry = keyboard_report_queue_peek();
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->report.keys[0], KC_A);
+    expect_pop(report(0, {KC_A}));
+    EXPECT_EQ(keyboard_report_queue_peek(), nullptr);
+}
+
+TEST_F(KeyboardReportQueue, OrderSurvivesWrappingAround) {
+    for (uint8_t round = 0; round < 3 * USB_KEYBOARD_REPORT_QUEUE_SIZE; round++) {
+        push(report(0, {(uint8_t)(KC_A + round % 20)}));
+        push(report(0, {}));
+        expect_pop(report(0, {(uint8_t)(KC_A + round % 20)}));
+        expect_pop(report(0, {}));
+    }
+}
+
+TEST_F(KeyboardReportQueue, FullQueueRejectsTapsInsteadOfReplacingThem) {
+    for (uint8_t i = 0; i < USB_KEYBOARD_REPORT_QUEUE_SIZE / 2; i++) {
+        push(report(0, {KC_A}));
+        push(report(0, {}));
+    }
+    auto tap = report(0, {KC_B});
+    EXPECT_FALSE(keyboard_report_queue_push(&tap));
+
+    // Once the host took a report there is room again, and nothing queued was changed
+    expect_pop(report(0, {KC_A}));
+    push(tap);
+    for (uint8_t i = 1; i < USB_KEYBOARD_REPORT_QUEUE_SIZE; i++) {
+        expect_pop(i % 2 ? report(0, {}) : report(0, {KC_A}));
+    }
+    expect_pop(tap);
+}
+
+TEST_F(KeyboardReportQueue, ClearDropsEverything) {
+    push(report(0, {KC_A}));
+    push(report(0, {}));
+    keyboard_report_queue_clear();
+    EXPECT_EQ(keyboard_report_queue_pop(), nullptr);
+}
+
+#ifndef USB_KEYBOARD_REPORT_COALESCE
+
+TEST_F(KeyboardReportQueue, EveryReportIsKeptWithoutCoalescing) {
+    push(report(0, {KC_A}));
+    push(report(0, {KC_A, KC_B}));
+
+    expect_pop(report(0, {KC_A}));
+    expect_pop(report(0, {KC_A, KC_B}));
+}
+
+#else
+
+TEST_F(KeyboardReportQueue, PressesAreCoalesced) {
+    push(report(0, {KC_A}));
+    push(report(MOD_BIT(KC_LEFT_SHIFT), {KC_A}));
+    push(report(MOD_BIT(KC_LEFT_SHIFT), {KC_A, KC_B}));
+
+    expect_pop(report(MOD_BIT(KC_LEFT_SHIFT), {KC_A, KC_B}));
+    EXPECT_EQ(keyboard_report_queue_pop(), nullptr);
+}
+
+TEST_F(KeyboardReportQueue, ReleasesAreCoalescedAfterTheReportOnTheWire) {
+    push(report(0, {KC_A, KC_B}));
+    expect_pop(report(0, {KC_A, KC_B}));
+
+    push(report(0, {KC_B}));
+    push(report(0, {}));
+
+    expect_pop(report(0, {}));
+    EXPECT_EQ(keyboard_report_queue_pop(), nullptr);
+}
+
+TEST_F(KeyboardReportQueue, TapIsNotCoalesced) {
+    push(report(0, {KC_A}));
+    push(report(0, {}));
+    push(report(0, {KC_A}));
+
+    expect_pop(report(0, {KC_A}));
+    expect_pop(report(0, {}));
+    expect_pop(report(0, {KC_A}));
+}
+
+TEST_F(KeyboardReportQueue, RolloverIsNotCoalesced) {
+    // B replaces A, so the report with only B pressed both releases and presses a key
+    push(report(0, {KC_A}));
+    push(report(0, {KC_B}));
+    push(report(0, {KC_B, KC_C}));
+
+    expect_pop(report(0, {KC_A}));
+    expect_pop(report(0, {KC_B}));
+    expect_pop(report(0, {KC_B, KC_C}));
+}
+
+TEST_F(KeyboardReportQueue, FullQueueStillCoalesces) {
+    for (uint8_t i = 0; i < USB_KEYBOARD_REPORT_QUEUE_SIZE / 2; i++) {
+        push(report(0, {KC_A}));
+        push(report(0, {}));
+    }
+    auto release = report(0, {});
+    EXPECT_TRUE(keyboard_report_queue_push(&release));
+
+    auto press = report(0, {KC_B});
+    EXPECT_FALSE(keyboard_report_queue_push(&press));
+}
+
+#endif
@@ -0,0 +1,10 @@
+keyboard_report_queue_DEFS := -DUSB_KEYBOARD_REPORT_QUEUE -DUSB_KEYBOARD_REPORT_QUEUE_SIZE=4
+keyboard_report_queue_INC := $(TMK_PATH)/protocol $(TMK_PATH)/protocol/chibios
+
+keyboard_report_queue_SRC := \
+	$(TMK_PATH)/protocol/chibios/tests/keyboard_report_queue_tests.cpp \
+	$(TMK_PATH)/protocol/chibios/keyboard_report_queue.c
+
+keyboard_report_queue_coalesce_DEFS := $(keyboard_report_queue_DEFS) -DUSB_KEYBOARD_REPORT_COALESCE
+keyboard_report_queue_coalesce_INC := $(keyboard_report_queue_INC)
+keyboard_report_queue_coalesce_SRC := $(keyboard_report_queue_SRC)
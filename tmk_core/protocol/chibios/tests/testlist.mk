@@ -0,0 +1 @@
+TEST_LIST += keyboard_report_queue keyboard_report_queue_coalesce
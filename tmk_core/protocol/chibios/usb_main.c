@@ -42,6 +42,9 @@
 #include "usb_device_state.h"
 #include "usb_descriptor.h"
 #include "usb_driver.h"
+#ifdef USB_KEYBOARD_REPORT_QUEUE
+#    include "keyboard_report_queue.h"
+#endif
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -53,6 +56,10 @@ extern keymap_config_t keymap_config;
 #    include "joystick.h"
 #endif
 
+#ifdef SCAN_STATS_ENABLE
+#    include "scan_stats.h"
+#endif
+
 /* ---------------------------------------------------------
  *       Global interface variables and declarations
  * ---------------------------------------------------------
@@ -79,6 +86,62 @@ static void keyboard_idle_timer_cb(void *arg);
 #endif
 
 report_keyboard_t keyboard_report_sent = {{0}};
+
+#ifdef USB_KEYBOARD_REPORT_QUEUE
+/* Keyboard reports are queued and sent from the IN callbacks,
+ * so that send_keyboard() never waits long for the host to poll */
+static usbep_t keyboard_report_entry_ep(const keyboard_report_entry_t *entry) {
+#    ifdef NKRO_ENABLE
+    if (entry->nkro) {
+        return SHARED_IN_EPNUM;
+    }
+#    endif
+    return KEYBOARD_IN_EPNUM;
+}
+
+/* start sending the oldest queued report if its endpoint is idle
+ * must be called from locked state */
+static void keyboard_report_queue_send_i(USBDriver *usbp) {
+    const keyboard_report_entry_t *entry = keyboard_report_queue_peek();
+    if (entry == NULL) {
+        return;
+    }
+
+    usbep_t ep = keyboard_report_entry_ep(entry);
+    if (usbGetTransmitStatusI(usbp, ep)) {
+        /* the IN callback of that endpoint will pick it up */
+        return;
+    }
+
+    entry = keyboard_report_queue_pop();
+    /* the idle rate resends what the host actually got */
+    keyboard_report_sent = entry->report;
+
+    uint8_t *data = (uint8_t *)&entry->report;
+    uint8_t  size = KEYBOARD_REPORT_SIZE;
+#    ifdef NKRO_ENABLE
+    if (entry->nkro) {
+        size = sizeof(struct nkro_report);
+    } else
+#    endif
+    if (!keyboard_protocol) { /* boot protocol */
+        data = (uint8_t *)&entry->report.mods;
+        size = 8;
+    }
+    usbStartTransmitI(usbp, ep, data, size);
+}
+
+/* wait until the host has taken the oldest queued report, returns false on timeout
+ * must be called from locked state, needs USB_USE_WAIT == TRUE in halconf.h */
+static bool keyboard_report_queue_wait_s(USBDriver *usbp) {
+    usbep_t ep = keyboard_report_entry_ep(keyboard_report_queue_peek());
+    if (usbGetTransmitStatusI(usbp, ep)) {
+        /* the IN callback sends the next report before this thread is resumed */
+        return osalThreadSuspendTimeoutS(&usbp->epc[ep]->in_state->thread, TIME_MS2I(10)) != MSG_TIMEOUT;
+    }
+    return true;
+}
+#endif /* USB_KEYBOARD_REPORT_QUEUE */
 #ifdef MOUSE_ENABLE
 report_mouse_t mouse_report_blank = {0};
 #endif /* MOUSE_ENABLE */
@@ -473,6 +536,9 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
 
         case USB_EVENT_CONFIGURED:
             osalSysLockFromISR();
+#ifdef USB_KEYBOARD_REPORT_QUEUE
+            keyboard_report_queue_clear();
+#endif
             /* Enable the endpoints specified into the configuration. */
 #ifndef KEYBOARD_SHARED_EP
             usbInitEndpointI(usbp, KEYBOARD_IN_EPNUM, &kbd_ep_config);
@@ -766,9 +832,15 @@ __attribute__((weak)) void restart_usb_driver(USBDriver *usbp) {
 /* keyboard IN callback hander (a kbd report has made it IN) */
 #ifndef KEYBOARD_SHARED_EP
 void kbd_in_cb(USBDriver *usbp, usbep_t ep) {
+    (void)ep;
+#    ifdef USB_KEYBOARD_REPORT_QUEUE
+    osalSysLockFromISR();
+    keyboard_report_queue_send_i(usbp);
+    osalSysUnlockFromISR();
+#    else
     /* STUB */
     (void)usbp;
-    (void)ep;
+#    endif
 }
 #endif
 
@@ -824,12 +896,36 @@ uint8_t keyboard_leds(void) {
 /* prepare and start sending a report IN
  * not callable from ISR or locked state */
 void send_keyboard(report_keyboard_t *report) {
+#ifdef USB_KEYBOARD_REPORT_QUEUE
+    keyboard_report_entry_t entry = {.report = *report};
+#    ifdef NKRO_ENABLE
+    entry.nkro = keymap_config.nkro && keyboard_protocol;
+#    endif
+#endif
+
     osalSysLock();
     if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
         goto unlock;
     }
 
-#ifdef NKRO_ENABLE
+#ifdef USB_KEYBOARD_REPORT_QUEUE
+    /* the IN callbacks send whatever is still queued, only wait for the host
+     * when the queue is full and the report cannot be coalesced */
+    while (!keyboard_report_queue_push(&entry)) {
+        /* a stalled host drops the report rather than the scan loop */
+        if (!keyboard_report_queue_wait_s(&USB_DRIVER)) {
+            goto unlock;
+        }
+
+        /* after osalThreadSuspendS returns USB status might have changed */
+        if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
+            goto unlock;
+        }
+        keyboard_report_queue_send_i(&USB_DRIVER);
+    }
+    keyboard_report_queue_send_i(&USB_DRIVER);
+#else
+#    ifdef NKRO_ENABLE
     if (keymap_config.nkro && keyboard_protocol) { /* NKRO protocol */
         /* need to wait until the previous packet has made it through */
         /* can rewrite this using the synchronous API, then would wait
@@ -850,7 +946,7 @@ void send_keyboard(report_keyboard_t *report) {
         }
         usbStartTransmitI(&USB_DRIVER, SHARED_IN_EPNUM, (uint8_t *)report, sizeof(struct nkro_report));
     } else
-#endif /* NKRO_ENABLE */
+#    endif /* NKRO_ENABLE */
     {  /* regular protocol */
         /* need to wait until the previous packet has made it through */
         /* busy wait, should be short and not very common */
@@ -877,6 +973,7 @@ void send_keyboard(report_keyboard_t *report) {
         usbStartTransmitI(&USB_DRIVER, KEYBOARD_IN_EPNUM, data, size);
     }
     keyboard_report_sent = *report;
+#endif
 
 unlock:
     osalSysUnlock();
@@ -904,7 +1001,7 @@ void send_mouse(report_mouse_t *report) {
         return;
     }
 
-    if (usbGetTransmitStatusI(&USB_DRIVER, MOUSE_IN_EPNUM)) {
+    while (usbGetTransmitStatusI(&USB_DRIVER, MOUSE_IN_EPNUM)) {
         /* Need to either suspend, or loop and call unlock/lock during
          * every iteration - otherwise the system will remain locked,
          * no interrupts served, so USB not going through as well.
@@ -931,9 +1028,16 @@ void send_mouse(report_mouse_t *report) {
 #ifdef SHARED_EP_ENABLE
 /* shared IN callback hander */
 void shared_in_cb(USBDriver *usbp, usbep_t ep) {
+    (void)ep;
+#    ifdef USB_KEYBOARD_REPORT_QUEUE
+    /* NKRO reports, or all keyboard reports with KEYBOARD_SHARED_EP, go out here */
+    osalSysLockFromISR();
+    keyboard_report_queue_send_i(usbp);
+    osalSysUnlockFromISR();
+#    else
     /* STUB */
     (void)usbp;
-    (void)ep;
+#    endif
 }
 #endif
 
@@ -950,11 +1054,13 @@ static void send_extra(uint8_t report_id, uint16_t data) {
         return;
     }
 
-    if (usbGetTransmitStatusI(&USB_DRIVER, SHARED_IN_EPNUM)) {
+    while (usbGetTransmitStatusI(&USB_DRIVER, SHARED_IN_EPNUM)) {
         /* Need to either suspend, or loop and call unlock/lock during
          * every iteration - otherwise the system will remain locked,
          * no interrupts served, so USB not going through as well.
-         * Note: for suspend, need USB_USE_WAIT == TRUE in halconf.h */
+         * Note: for suspend, need USB_USE_WAIT == TRUE in halconf.h
+         * The IN callback may have sent a queued keyboard report before
+         * waking us up, so the endpoint is checked again. */
         if (osalThreadSuspendTimeoutS(&(&USB_DRIVER)->epc[SHARED_IN_EPNUM]->in_state->thread, TIME_MS2I(10)) == MSG_TIMEOUT) {
             osalSysUnlock();
             return;
@@ -989,7 +1095,7 @@ void send_programmable_button(uint32_t data) {
         return;
     }
 
-    if (usbGetTransmitStatusI(&USB_DRIVER, SHARED_IN_EPNUM)) {
+    while (usbGetTransmitStatusI(&USB_DRIVER, SHARED_IN_EPNUM)) {
         /* Need to either suspend, or loop and call unlock/lock during
          * every iteration - otherwise the system will remain locked,
          * no interrupts served, so USB not going through as well.
@@ -1096,6 +1202,13 @@ __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
     // so users can opt to not handle data coming in.
+#    ifdef SCAN_STATS_ENABLE
+    // Custom handlers need to forward these to scan_stats_raw_hid_receive() themselves
+    if (data[0] == SCAN_STATS_RAW_HID_ID) {
+        scan_stats_raw_hid_receive(data, length);
+        raw_hid_send(data, length);
+    }
+#    endif
 }
 
 void raw_hid_task(void) {
@@ -35,6 +35,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "raw_hid.h"
 #endif
 
+#ifdef SCAN_STATS_ENABLE
+#    include "scan_stats.h"
+#endif
+
 #if defined(CONSOLE_ENABLE)
 #    define RBUF_SIZE 128
 #    include "ring_buffer.h"
@@ -154,6 +158,13 @@ __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
     // so users can opt to not handle data coming in.
+#    ifdef SCAN_STATS_ENABLE
+    // Custom handlers need to forward these to scan_stats_raw_hid_receive() themselves
+    if (data[0] == SCAN_STATS_RAW_HID_ID) {
+        scan_stats_raw_hid_receive(data, length);
+        raw_hid_send(data, length);
+    }
+#    endif
 }
 
 void raw_hid_task(void) {